@@ -0,0 +1,113 @@
+/***  Spatial correlation, Ver 0.1, Date: 19 Oct 2026 **************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <math.h>
+#include "corr.h"
+#include "utils.h"
+
+using namespace std;
+using namespace Eigen;
+
+void SpinCorrelation::init(int L1, int L2, const Vector3f& a, const Vector3f& b) {
+    this->L1 = L1;
+    this->L2 = L2;
+
+    for (int c = 0; c < 3; c++)
+        m[c].assign(L1 * L2, 0);
+    s.assign(L1 * L2, 0);
+    g.assign(L1 * L2, 0);
+
+    // The reciprocal bases in the plane of a and b
+    const Vector3f n = a.cross(b);
+    const Vector3f as = 2 * pi * b.cross(n) / a.dot(b.cross(n)),
+                   bs = 2 * pi * n.cross(a) / b.dot(n.cross(a));
+
+    // The shortest non-zero reciprocal vectors among ±a⁎/L₁, ±b⁎/L₂ and ±(a⁎/L₁ ± b⁎/L₂)
+    const int k[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+    float q[4];
+    qmin = HUGE_VAL;
+    for (int p = 0; p < 4; p++) {
+        q[p] = (k[p][0] * as / L1 + k[p][1] * bs / L2).norm();
+        qmin = min(qmin, double(q[p]));
+    }
+    kmin.clear();
+    for (int p = 0; p < 4; p++)
+        if (q[p] < qmin * (1 + 1e-4))
+            kmin.push_back(make_pair(k[p][0], k[p][1]));
+}
+
+void SpinCorrelation::fft2(vector<complex<double> >& x, bool inverse) { // 2D FFT in place
+    vector<complex<double> > in(max(L1, L2)), out(max(L1, L2));
+
+    for (int i = 0; i < L1; i++) {          // rows
+        for (int j = 0; j < L2; j++)
+            in[j] = x[i * L2 + j];
+        if (inverse)
+            fft.inv(&out[0], &in[0], L2);
+        else
+            fft.fwd(&out[0], &in[0], L2);
+        for (int j = 0; j < L2; j++)
+            x[i * L2 + j] = out[j];
+    }
+
+    for (int j = 0; j < L2; j++) {          // columns
+        for (int i = 0; i < L1; i++)
+            in[i] = x[i * L2 + j];
+        if (inverse)
+            fft.inv(&out[0], &in[0], L1);
+        else
+            fft.fwd(&out[0], &in[0], L1);
+        for (int i = 0; i < L1; i++)
+            x[i * L2 + j] = out[i];
+    }
+}
+
+void SpinCorrelation::transform() {
+    const int N = L1 * L2;
+
+    for (int c = 0; c < 3; c++)
+        fft2(m[c], false);
+
+    // S(q) and its inverse transform; the inverse FFT of Eigen is scaled by 1/N.
+    vector<complex<double> > x(N);
+    for (int k = 0; k < N; k++) {
+        s[k] = (norm(m[0][k]) + norm(m[1][k]) + norm(m[2][k])) / N;
+        x[k] = s[k];
+    }
+
+    fft2(x, true);
+    for (int k = 0; k < N; k++)
+        g[k] = x[k].real();
+}
+
+double SpinCorrelation::S(int k1, int k2) const { // structure factor at q = k₁ a⁎/L₁ + k₂ b⁎/L₂
+    k1 = ((k1 % L1) + L1) % L1;
+    k2 = ((k2 % L2) + L2) % L2;
+    return s[k1 * L2 + k2];
+}
+
+double SpinCorrelation::G(int i, int j) const { // correlation function at r = i a + j b
+    i = ((i % L1) + L1) % L1;
+    j = ((j % L2) + L2) % L2;
+    return g[i * L2 + j];
+}
+
+double SpinCorrelation::Smin() const {      // average of S(q) on the shortest non-zero q
+    double sum = 0;
+    for (size_t p = 0; p < kmin.size(); p++) // S(-q) == S(q)
+        sum += S(kmin[p].first, kmin[p].second);
+    return sum / kmin.size();
+}
+
+double SpinCorrelation::xi() const {        // second-moment correlation length
+    const double r = S0() / Smin() - 1;
+    return (r > 0) ? sqrt(r) / (2 * sin(qmin / 2)) : 0;
+}
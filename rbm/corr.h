@@ -0,0 +1,60 @@
+/***  Spatial correlation, Ver 0.1, Date: 19 Oct 2026 **************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * SpinCorrelation calculates the spin-spin correlation function G(r) and the structure factor S(q) of the
+ * orientations on a periodic L₁ x L₂ Bravais lattice by the FFT in O(N log N), where the dipole of the cell
+ * (i, j) is at i a + j b and it has the index i L₂ + j. The reciprocal lattice vectors are q = k₁ a⁎/L₁ + k₂ b⁎/L₂,
+ * where a⁎·a = b⁎·b = 2π and a⁎·b = b⁎·a = 0.
+ *   S(q) = |Σᵢ μᵢ e^{-i q·rᵢ}|² / N,
+ *   G(r) = Σᵢ μᵢ·μ(rᵢ + r) / N = Σ_q S(q) e^{i q·r} / N.
+ * The correlation length is estimated by the second-moment estimator
+ *   ξ = √(S(0)/S(q_min) - 1) / (2 sin(|q_min|/2)),
+ * where S(q_min) is averaged over the shortest non-zero reciprocal vectors, e.g. ±a⁎/L, ±b⁎/L and ±(a⁎ + b⁎)/L
+ * for the triangular lattice of rbm.cpp.
+ */
+
+#ifndef CORR_H
+
+#define CORR_H
+
+#include <complex>
+#include <vector>
+#include <eigen3/Eigen/Dense>
+#include <eigen3/unsupported/Eigen/FFT>
+
+class SpinCorrelation {
+  public:
+    void init(int L1, int L2, const Eigen::Vector3f& a, const Eigen::Vector3f& b);
+
+    // calculates S(q) and G(r) of the orientations mu[offset + stride * (i L₂ + j)].
+    template <typename Vec>
+    void compute(const Vec* mu, int offset = 0, int stride = 1) {
+        for (int k = 0; k < L1 * L2; k++)
+            for (int c = 0; c < 3; c++)
+                m[c][k] = std::complex<double>(mu[offset + stride * k][c], 0);
+        transform();
+    }
+
+    double S(int k1, int k2) const;         // structure factor at q = k₁ a⁎/L₁ + k₂ b⁎/L₂
+    double G(int i, int j) const;           // correlation function at r = i a + j b
+    double S0() const { return S(0, 0); }
+    double Smin() const;                    // average of S(q) on the shortest non-zero q
+    double xi() const;                      // second-moment correlation length [l]
+  private:
+    int L1, L2;
+    double qmin;                            // |q_min|
+    std::vector<std::pair<int, int> > kmin; // (k₁, k₂) of the shortest non-zero q (one of each ±q pair)
+    std::vector<std::complex<double> > m[3];// Fourier transform of the components of μ
+    std::vector<double> s, g;               // S(q) and G(r)
+    Eigen::FFT<double> fft;
+    void fft2(std::vector<std::complex<double> >& x, bool inverse); // 2D FFT in place
+    void transform();
+};
+
+#endif
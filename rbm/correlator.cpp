@@ -0,0 +1,144 @@
+/***  Multiple-tau correlator, Ver 0.1, Date: 19 Oct 2026 *********************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <math.h>
+#include <algorithm>
+#include <eigen3/unsupported/Eigen/FFT>
+#include "correlator.h"
+
+using namespace std;
+
+void MultiTauCorrelator::reset() { // removes the samples.
+    n = 0;
+    mean.assign(dim, 0);
+    shift.assign(levels, vector<double>(p * dim, 0));
+    head.assign(levels, 0);
+    filled.assign(levels, 0);
+    sum.assign(levels, vector<double>(p, 0));
+    count.assign(levels, vector<long>(p, 0));
+    acc.assign(levels, vector<double>(dim, 0));
+    nAcc.assign(levels, 0);
+}
+
+void MultiTauCorrelator::add(const double* x) { // adds the sample x[0 ... dim-1] of the next step.
+    for (int d = 0; d < dim; d++)
+        mean[d] += x[d];
+    n++;
+    add(0, x);
+}
+
+void MultiTauCorrelator::add(int k, const double* x) { // adds x to the level k.
+
+    // x is the newest value of the level, and the value j steps of the level before it is at (head + j) mod p.
+    head[k] = (head[k] + p - 1) % p;
+    copy(x, x + dim, &shift[k][head[k] * dim]);
+    filled[k] = min(filled[k] + 1, p);
+
+    for (int j = (k == 0) ? 0 : p / m; j < filled[k]; j++) {
+        const double* y = &shift[k][((head[k] + j) % p) * dim];
+        double s = 0;
+        for (int d = 0; d < dim; d++)
+            s += x[d] * y[d];
+        sum[k][j] += s;
+        count[k][j]++;
+    }
+
+    for (int d = 0; d < dim; d++)
+        acc[k][d] += x[d];
+    if (++nAcc[k] == m) {
+        if (k + 1 < levels) {
+            for (int d = 0; d < dim; d++)
+                acc[k][d] /= m;
+            add(k + 1, &acc[k][0]);
+        }
+        acc[k].assign(dim, 0);
+        nAcc[k] = 0;
+    }
+}
+
+void MultiTauCorrelator::correlation(vector<long>& lag, vector<double>& C, vector<double>& Cc,
+                                     vector<long>& samples) const {
+    lag.clear();
+    C.clear();
+    Cc.clear();
+    samples.clear();
+    double mean2 = 0;
+    for (int d = 0; d < dim; d++) {
+        const double x = mean[d] / max(n, 1L);
+        mean2 += x * x;
+    }
+
+    long scale = 1;                         // mᵏ
+    for (int k = 0; k < levels; k++, scale *= m)
+        for (int j = (k == 0) ? 0 : p / m; j < p; j++)
+            if (count[k][j] > 0) {
+                lag.push_back(j * scale);
+                C.push_back(sum[k][j] / count[k][j]);
+                Cc.push_back(C.back() - mean2);
+                samples.push_back(count[k][j]);
+            }
+}
+
+bool MultiTauCorrelator::susceptibility(double h, vector<double>& omega, vector<complex<double> >& chi,
+                                        int perDecade) const {
+    omega.clear();
+    chi.clear();
+    vector<long> lag, samples;
+    vector<double> C, Cc;
+    correlation(lag, C, Cc, samples);
+    if ((lag.size() < 2) || (Cc[0] <= 0))
+        return false;
+
+    // φ is integrated up to its first zero, after which the few samples of the long lags are mostly noise.
+    size_t last = 1;
+    while ((last + 1 < lag.size()) && (Cc[last] > 0))
+        last++;
+
+    // φ on the uniform grid of the step g (a multiple of the lag 1), with the zero padding
+    const long maxPoints = 1L << 20;
+    const long span = lag[last];
+    const long g = max(1L, (span + maxPoints - 1) / maxPoints);
+    long size = 1;
+    while (size < 2 * (span / g + 1))
+        size *= 2;
+    vector<complex<double> > phi(size, 0.), F;
+    size_t k = 0;
+    for (long i = 0; i * g <= span; i++) {
+        const double tau = double(i * g);
+        while ((k + 1 < last) && (lag[k + 1] < tau))
+            k++;
+        const double w = min(1., max(0., (tau - lag[k]) / double(lag[k + 1] - lag[k])));
+        phi[i] = ((1 - w) * Cc[k] + w * Cc[k + 1]) / Cc[0];
+    }
+
+    Eigen::FFT<double> fft;
+    fft.fwd(F, phi);
+
+    // The integral of the piecewise linear φ of the step H = g h is exact:
+    //   ∫₀^∞ φ e^{-iωτ} dτ = H sinc²(ωH/2) F(ω) - φ(0) (i/ω - (e^{iωH} - 1)/(ω²H)),
+    // where the last term removes the half of the first hat function at τ < 0. The frequencies are thinned out
+    // to a logarithmic grid.
+    const double H = g * h;
+    const double step = pow(10., 1. / perDecade);
+    const complex<double> I(0, 1);
+    double next = 0;
+    for (long i = 1; i <= size / 2; i++) {
+        const double w = 2 * M_PI * i / (size * H);
+        if (w < next)
+            continue;
+        next = w * step;
+        const double sinc = sin(w * H / 2) / (w * H / 2);
+        const complex<double> integral = H * sinc * sinc * F[i]
+                                       - phi[0] * (I / w - (exp(I * w * H) - 1.) / (w * w * H));
+        omega.push_back(w);
+        chi.push_back(1. - I * w * integral);
+    }
+    return true;
+}
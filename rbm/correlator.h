@@ -0,0 +1,62 @@
+/***  Multiple-tau correlator, Ver 0.1, Date: 19 Oct 2026 *********************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * MultiTauCorrelator estimates the time correlation C(τ) = 〈x(t)·x(t+τ)〉 of a vector x of dim components,
+ * which is added in each sampling step, over many decades of τ with O(log τ) memory (the multiple-tau
+ * correlator). The level 0 keeps the last p samples and the lags 0 ... p-1; each next level gets the averages of
+ * m samples of its previous level and keeps the lags j mᵏ of j = p/m ... p-1. So the lags are uniform up to p and
+ * logarithmic after it, and a lag of the level k is averaged over mᵏ steps.
+ *
+ * susceptibility() gives the complex susceptibility of the fluctuation-dissipation theorem,
+ *   χ(ω)/χ₀ = 1 - iω ∫₀^∞ φ(τ) e^{-iωτ} dτ = χ'(ω)/χ₀ - i χ''(ω)/χ₀,
+ * where φ(τ) = C_c(τ)/C_c(0) is the normalized connected correlation, C_c(τ) = C(τ) - |〈x〉|², up to its first
+ * zero. φ is interpolated linearly on a uniform grid, and its integral is calculated exactly by the FFT with zero
+ * padding; the frequencies are thinned out to a logarithmic grid.
+ */
+
+#ifndef CORRELATOR_H
+
+#define CORRELATOR_H
+
+#include <complex>
+#include <vector>
+
+class MultiTauCorrelator {
+  public:
+    MultiTauCorrelator(int dim = 3, int p = 16, int m = 2, int levels = 24) : dim(dim), p(p), m(m),
+        levels(levels) { reset(); }
+
+    void reset();                           // removes the samples.
+    void add(const double* x);              // adds the sample x[0 ... dim-1] of the next step.
+
+    long samples() const { return n; }
+
+    // the lags [steps], C(τ) and C_c(τ) of the lags which have any sample, in the increasing order of the lags.
+    void correlation(std::vector<long>& lag, std::vector<double>& C, std::vector<double>& Cc,
+                     std::vector<long>& count) const;
+
+    // χ(ω)/χ₀ on about perDecade frequencies of each decade, where h is the time of a step; it returns false if
+    // there is not any fluctuation.
+    bool susceptibility(double h, std::vector<double>& omega, std::vector<std::complex<double> >& chi,
+                        int perDecade = 20) const;
+  private:
+    int dim, p, m, levels;
+    long n;                                 // number of the samples
+    std::vector<double> mean;               // Σ x
+    std::vector<std::vector<double> > shift;// the last p values of each level, the newest at head[k]
+    std::vector<int> head, filled;
+    std::vector<std::vector<double> > sum;  // Σ x(t)·x(t+τ) of the lags of each level
+    std::vector<std::vector<long> > count;
+    std::vector<std::vector<double> > acc;  // the sum of the values of each level for its next level
+    std::vector<int> nAcc;
+
+    void add(int k, const double* x);       // adds x to the level k.
+};
+
+#endif
@@ -0,0 +1,160 @@
+/***  Ensemble reducer, Ver 0.1, Date: 19 Oct 2026 *****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "ensemble.h"
+
+using namespace std;
+
+void EnsembleReducer::init(const vector<string>& names) { // removes all data and sets the names.
+    this->names = names;
+    data.clear();
+    realizations = 0;
+}
+
+void EnsembleReducer::add(int id, const double* x) { // adds the observables of a realization at the index id.
+    if (id < 1)
+        return;
+    if (int(data.size()) < id)
+        data.resize(id, vector<Moments>(names.size()));
+
+    vector<Moments>& row = data[id - 1];
+    for (size_t k = 0; k < names.size(); k++) {
+        Moments& m = row[k];
+        m.n++;
+        const double d = x[k] - m.mean;
+        m.mean += d / m.n;
+        m.M2   += d * (x[k] - m.mean);
+    }
+}
+
+bool EnsembleReducer::merge(const EnsembleReducer& E) { // merges E into this.
+    if (names.empty())
+        names = E.names;
+    if (names != E.names)
+        return false;
+
+    if (data.size() < E.data.size())
+        data.resize(E.data.size(), vector<Moments>(names.size()));
+
+    for (size_t id = 0; id < E.data.size(); id++)
+        for (size_t k = 0; k < names.size(); k++) {
+            Moments& a = data[id][k];
+            const Moments& b = E.data[id][k];
+            if (b.n == 0)
+                continue;
+
+            const long n = a.n + b.n;
+            const double d = b.mean - a.mean;
+            a.M2  += b.M2 + d * d * double(a.n) * b.n / n;
+            a.mean += d * b.n / n;
+            a.n = n;
+        }
+    realizations += E.realizations;
+    return true;
+}
+
+double EnsembleReducer::mean(int id, int k) const {
+    return data[id - 1][k].mean;
+}
+
+double EnsembleReducer::variance(int id, int k) const {
+    const Moments& m = data[id - 1][k];
+    return (m.n > 1) ? m.M2 / (m.n - 1) : 0;
+}
+
+void EnsembleReducer::write(ostream& os) const { // exports the consolidated CSV data.
+    os << "# realizations: " << realizations << '\n'
+       << "id, n";
+    for (size_t k = 0; k < names.size(); k++)
+        os << ", " << names[k] << ", " << names[k] << " var";
+    os << '\n' << setprecision(10);
+
+    for (size_t id = 0; id < data.size(); id++) {
+        os << id + 1 << ", " << (names.empty() ? 0 : data[id][0].n);
+        for (size_t k = 0; k < names.size(); k++)
+            os << ", " << data[id][k].mean << ", " << variance(int(id) + 1, int(k));
+        os << '\n';
+    }
+    os.flush();
+}
+
+bool EnsembleReducer::read(istream& is) { // reads the consolidated CSV data.
+    string line;
+    realizations = 0;
+    names.clear();
+    data.clear();
+
+    // header
+    if (!getline(is, line) || (sscanf(line.c_str(), "# realizations: %ld", &realizations) != 1))
+        return false;
+    if (!getline(is, line))
+        return false;
+
+    istringstream header(line);
+    string item;
+    int col = 0;
+    while (getline(header, item, ',')) {
+        item.erase(0, item.find_first_not_of(' '));
+        if ((col >= 2) && (col % 2 == 0))  // the columns of the variances are omitted.
+            names.push_back(item);
+        col++;
+    }
+
+    // data
+    while (getline(is, line)) {
+        if (line.empty())
+            continue;
+        istringstream row(line);
+        char comma;
+        int id;
+        long n;
+        row >> id >> comma >> n;
+        if (!row || (id < 1))
+            return false;
+
+        vector<Moments> m(names.size());
+        for (size_t k = 0; k < names.size(); k++) {
+            double var;
+            row >> comma >> m[k].mean >> comma >> var;
+            m[k].n  = n;
+            m[k].M2 = (n > 1) ? var * (n - 1) : 0;
+        }
+        if (!row)
+            return false;
+
+        if (int(data.size()) < id)
+            data.resize(id, vector<Moments>(names.size()));
+        data[id - 1] = m;
+    }
+    return true;
+}
+
+bool EnsembleReducer::save(const string& file) const {
+    // The data is written to a temporary file which then replaces the file; so a crash during writing
+    // does not destroy the previous data.
+    const string temp = file + ".tmp";
+    {
+        ofstream os(temp.c_str(), ios_base::out | ios_base::trunc);
+        if (!os.good())
+            return false;
+        write(os);
+    }
+    return rename(temp.c_str(), file.c_str()) == 0;
+}
+
+bool EnsembleReducer::load(const string& file) {
+    ifstream is(file.c_str());
+    return is.good() && read(is);
+}
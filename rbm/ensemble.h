@@ -0,0 +1,58 @@
+/***  Ensemble reducer, Ver 0.1, Date: 19 Oct 2026 *****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * EnsembleReducer merges the observables of the realizations into the running means and variances per output
+ * index (Welford's algorithm), so a run over many realizations writes one consolidated file instead of a file
+ * per realization. The partial results of several processes (e.g. the shards of a job array) are merged by
+ * merge() with the pairwise formula of Chan et al.
+ *
+ * The consolidated file is a CSV file:
+ *   # realizations: <number of finished realizations>
+ *   id, n, <name₁>, <name₁> var, <name₂>, <name₂> var, ...
+ *   1, 500, 0.1, 0, ...
+ * where n is the number of samples and "var" is the sample variance of the observable over the realizations.
+ */
+
+#ifndef ENSEMBLE_H
+
+#define ENSEMBLE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+class EnsembleReducer {
+  public:
+    EnsembleReducer() : realizations(0) {}
+    void init(const std::vector<std::string>& names); // removes all data and sets the names of observables.
+    void add(int id, const double* x);      // adds the observables x[] of a realization at the output index id.
+    void finish() { realizations++; }       // marks the end of a realization.
+    bool merge(const EnsembleReducer& E);   // merges E into this; false if the observables are different.
+
+    int size() const { return int(names.size()); }
+    double mean(int id, int k) const;       // mean of the kᵗʰ observable at the output index id
+    double variance(int id, int k) const;   // sample variance of the kᵗʰ observable at the output index id
+
+    void write(std::ostream& os) const;     // exports the consolidated CSV data.
+    bool read(std::istream& is);            // reads the consolidated CSV data.
+    bool save(const std::string& file) const;
+    bool load(const std::string& file);
+  private:
+    struct Moments {
+        long   n;                           // number of samples
+        double mean,                        // running mean
+               M2;                          // Σ (x - mean)²
+        Moments() : n(0), mean(0), M2(0) {}
+    };
+    std::vector<std::string> names;         // names of the observables
+    std::vector<std::vector<Moments> > data;// data[id - 1][k]
+    long realizations;                      // number of the finished realizations
+};
+
+#endif
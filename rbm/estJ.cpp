@@ -1,134 +1,309 @@
-/***  Estimate the J(∞), Ver 1.00, Date: 22 May 2022 **************************
- ***                                                                        ***
- ***  Copyleft (ɔ) Nasim 2020-22, All lefts reserved!                       ***
- ***                                                                        ***
- ******************************************************************************
-
- * This code is under construction. It might contain some errors.
- * So you can try it at your own risk!
- */
-
-//#define DEBUG_MODE                          // Activate debug mode
-//#define NO_WAIT                             // Deactivate wait() at the end of code; see utils.h
-
-#include <cstdlib>
-#include <stdio.h>
-#include <iostream>
-#include <fstream>
-#include <math.h>
-#include <eigen3/Eigen/Dense>
-#include "utils.h"
-#include "estJ.h"
-
-using namespace std;
-using namespace Eigen;
-
-// Constants
-// =========
-const int N = 30;                           // The maximum radius of circle which includes dipoles is ~10N.
-
-const static IOFormat CSVFormat(StreamPrecision, DontAlignCols, ", ", "\n");
-
-double estimation(int R, int& count,        // Estimate the J(∞), where a and b are the bases of the Bravais
-                  const Vector3f& a,        // lattice, and count returns number of dipoles included in the
-                  const Vector3f& b);       // estimation.
-
-Matrix3f couplingJ(const Vector3f& r) { // The coupling dyadic between two dipoles with relative displacement r.
-    /** The coupling dyadic is defined as,
-     * \f[\stackrel{\scriptstyle\leftrightarrow}{\mathbf{J}}(\mathbf{r}) = \left\{
-     * \begin{array}{ll}
-     * \displaystyle\frac{ 3\mathbf{r}\mathbf{r} - |\mathbf{r}|^2 \mathrm{I}_{3\times3} } {|\mathbf{r}|^5} & \mathbf{r}| > 0,\\
-     * \mathrm{O}_{3\times3} & |\mathbf{r}| = 0
-     * \end{array}
-     * \right.\f]
-     * This function is optimized to speed up the evaluation of the coupling dyadic more than 3 times.
-     * The body of the function before optimization:
-     * const float r2 = norm2(r);
-     * if ( r2 > 0.1e-7 )
-     *     return ( 3*Dyadic(r) - r2 * I3x3 ) / ipow(norm(r), 5);
-     * else
-     *     return O3x3;*/
-    static const float eps = 1e-7;
-    const float r2  = r.squaredNorm();
-    if ( r2 > eps ) {                       // self-interaction of dipoles is omitted
-        const float x = 1 / (sqr(r2) * sqrt(r2)); // x = |r|^{-5}
-
-        return ( 3 * r * r.transpose() - r2 * Matrix3f::Identity() ) * x;
-    } else
-        return Matrix3f::Zero();
-}
-
-// Following function gets the a and b as bases of the triangular Bravais lattice, and
-// calculates the J(∞). Then stores it in the 1st line of J_inf.csv text file.
-void Store_Jinf(const Vector3f& a, const Vector3f& b) {
-    lout << "\nEstimating J(∞) ..." << endl;
-
-    ofstream res("J_inf.csv",               // The result of estimation
-                 std::ios_base::out | std::ios_base::trunc);
-
-    lout.start();                           // calculates the executing time of the
-                                            // main section of code.
-    double J11[N];
-    int count[N];
-    double Sx  = 0,                         // used for the linear fit
-           Sy  = 0,
-           Sxy = 0,
-           Sx2 = 0;
-
-    for (int i=0; i < N; i++) {
-        int R = 10*(i+1);
-        J11[i] = estimation(R, count[i], a, b);
-
-        float x = 1. / R;
-        Sx  += x;
-        Sx2 += sqr(x);
-        Sxy += x * J11[i];
-        Sy  += J11[i];
-    }
-
-    Sx  /= N;
-    Sy  /= N;
-    Sxy /= N;
-    Sx2 /= N;
-
-    double slope = ( Sxy - Sx*Sy ) / ( Sx2 - sqr(Sx) );
-    double intercept = Sy - slope * Sx;
-
-    lout << "\nJ₁₁(∞) = " << fixed << setprecision(5) << intercept << '\n' << endl
-         << resetiosflags(std::ios_base::floatfield | std::ios_base::showpoint)
-         << setprecision(-1);               // resets the stream format
-
-    res  << intercept << endl;
-    res << "R, 1/R, N, J(R)" << endl;
-    for (int i=0; i < N; i++) {
-        int R = 10*(i+1);
-        res << R << ", " << 1./R << ", " << count[i] << ", " << J11[i] << '\n';
-    }
-    res.flush();
-
-    lout << "Finish estimating J(∞), ";
-    lout.stop();                            // calculates the executing time
-}
-
-// Following function estimates the J(∞), where a and b are the bases of the Bravais lattice, and count returns
-//number of dipoles included in the estimation.
-double estimation(int R, int& count, const Vector3f& a, const Vector3f& b) {
-    count = 0;
-    Matrix3d JTotal = Matrix3d::Zero();
-
-    for (int i = -2*R; i<2*R; i++)
-        for (int j = -2*R; j<2*R; j++) {    // Total coupling of the circular area
-            if ( (i == 0) && (j == 0) ) continue;
-
-            const Vector3f r = i * a + j * b;
-
-            if ( r.norm() <= R ) {
-                JTotal += couplingJ(r).cast<double>(); // only includes the symmetrical circular area with radius of 10n.
-                ++count;
-            }
-        }
-    lout << "\nJₜ(R = " << R << "): [\n"
-         << fixed << setprecision(3) << JTotal.format(CSVFormat) << "]" << endl;
-
-    return JTotal(1,1);
-}
+/***  Estimate the J(∞), Ver 1.00, Date: 22 May 2022 **************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-22, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+//#define DEBUG_MODE                          // Activate debug mode
+//#define NO_WAIT                             // Deactivate wait() at the end of code; see utils.h
+
+#include <cstdlib>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <eigen3/Eigen/Dense>
+#include "utils.h"
+#include "estJ.h"
+#include "lattice.h"
+
+using namespace std;
+using namespace Eigen;
+
+// Constants
+// =========
+const int N = 30;                           // The maximum radius of circle which includes dipoles is ~10N.
+
+const static IOFormat CSVFormat(StreamPrecision, DontAlignCols, ", ", "\n");
+
+double estimation(int R, int& count,        // Estimate the J(∞), where a and b are the bases of the Bravais
+                  const Vector3f& a,        // lattice, and count returns number of dipoles included in the
+                  const Vector3f& b);       // estimation.
+Matrix3d estimation(int R, int& count,      // Estimate the J_s(R) of the site s of the cell of lat.
+                    const Lattice& lat, int s);
+
+Matrix3f couplingJ(const Vector3f& r) { // The coupling dyadic between two dipoles with relative displacement r.
+    /** The coupling dyadic is defined as,
+     * \f[\stackrel{\scriptstyle\leftrightarrow}{\mathbf{J}}(\mathbf{r}) = \left\{
+     * \begin{array}{ll}
+     * \displaystyle\frac{ 3\mathbf{r}\mathbf{r} - |\mathbf{r}|^2 \mathrm{I}_{3\times3} } {|\mathbf{r}|^5} & \mathbf{r}| > 0,\\
+     * \mathrm{O}_{3\times3} & |\mathbf{r}| = 0
+     * \end{array}
+     * \right.\f]
+     * This function is optimized to speed up the evaluation of the coupling dyadic more than 3 times.
+     * The body of the function before optimization:
+     * const float r2 = norm2(r);
+     * if ( r2 > 0.1e-7 )
+     *     return ( 3*Dyadic(r) - r2 * I3x3 ) / ipow(norm(r), 5);
+     * else
+     *     return O3x3;*/
+    static const float eps = 1e-7;
+    const float r2  = r.squaredNorm();
+    if ( r2 > eps ) {                       // self-interaction of dipoles is omitted
+        const float x = 1 / (sqr(r2) * sqrt(r2)); // x = |r|^{-5}
+
+        return ( 3 * r * r.transpose() - r2 * Matrix3f::Identity() ) * x;
+    } else
+        return Matrix3f::Zero();
+}
+
+void CouplingBatch::flush() { // adds the current batch to S.
+    static const float eps = 1e-7;
+    double xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+    long c = 0;
+
+    #pragma omp simd reduction(+: xx, xy, xz, yy, yz, zz, c)
+    for (int k = 0; k < n; k++) {
+        const float r2 = x[k]*x[k] + y[k]*y[k] + z[k]*z[k];
+        const bool in = (r2 > eps) && (r2 <= r2Max);
+        const float q = 1 / sqrtf(in ? r2 : 1); // q = |r|⁻¹
+        const float w = in ? sqr(sqr(q)) * q : 0; // w = |r|⁻⁵
+        const float w3 = 3 * w;
+        xx += w3 * x[k] * x[k] - w * r2;
+        xy += w3 * x[k] * y[k];
+        xz += w3 * x[k] * z[k];
+        yy += w3 * y[k] * y[k] - w * r2;
+        yz += w3 * y[k] * z[k];
+        zz += w3 * z[k] * z[k] - w * r2;
+        c += in;
+    }
+
+    S[0] += xx;  S[1] += xy;  S[2] += xz;
+    S[3] += yy;  S[4] += yz;  S[5] += zz;
+    included += c;
+    n = 0;
+}
+
+Matrix3d CouplingBatch::sum() { // Σ J(r) of the added displacements
+    flush();
+    Matrix3d J;
+    J << S[0], S[1], S[2],
+         S[1], S[3], S[4],
+         S[2], S[4], S[5];
+    return J;
+}
+
+long CouplingBatch::count() { // number of the included displacements
+    flush();
+    return included;
+}
+
+void CouplingBatch::clear() { // removes the displacements and the sum
+    n = 0;
+    included = 0;
+    for (int k = 0; k < 6; k++)
+        S[k] = 0;
+}
+
+// Following function gets the a and b as bases of the triangular Bravais lattice, and
+// calculates the J(∞). Then stores it in the 1st line of J_inf.csv text file.
+void Store_Jinf(const Vector3f& a, const Vector3f& b) {
+    lout << "\nEstimating J(∞) ..." << endl;
+
+    ofstream res("J_inf.csv",               // The result of estimation
+                 std::ios_base::out | std::ios_base::trunc);
+
+    lout.start();                           // calculates the executing time of the
+                                            // main section of code.
+    double J11[N];
+    int count[N];
+    double Sx  = 0,                         // used for the linear fit
+           Sy  = 0,
+           Sxy = 0,
+           Sx2 = 0;
+
+    for (int i=0; i < N; i++) {
+        int R = 10*(i+1);
+        J11[i] = estimation(R, count[i], a, b);
+
+        float x = 1. / R;
+        Sx  += x;
+        Sx2 += sqr(x);
+        Sxy += x * J11[i];
+        Sy  += J11[i];
+    }
+
+    Sx  /= N;
+    Sy  /= N;
+    Sxy /= N;
+    Sx2 /= N;
+
+    double slope = ( Sxy - Sx*Sy ) / ( Sx2 - sqr(Sx) );
+    double intercept = Sy - slope * Sx;
+
+    lout << "\nJ₁₁(∞) = " << fixed << setprecision(5) << intercept << '\n' << endl
+         << resetiosflags(std::ios_base::floatfield | std::ios_base::showpoint)
+         << setprecision(-1);               // resets the stream format
+
+    res  << intercept << endl;
+    res << "R, 1/R, N, J(R)" << endl;
+    for (int i=0; i < N; i++) {
+        int R = 10*(i+1);
+        res << R << ", " << 1./R << ", " << count[i] << ", " << J11[i] << '\n';
+    }
+    res.flush();
+
+    lout << "Finish estimating J(∞), ";
+    lout.stop();                            // calculates the executing time
+}
+
+// Following function estimates the J(∞), where a and b are the bases of the Bravais lattice, and count returns
+//number of dipoles included in the estimation.
+double estimation(int R, int& count, const Vector3f& a, const Vector3f& b) {
+    CouplingBatch batch(float(R) * R);      // only includes the symmetrical circular area with radius of 10n.
+
+    // Total coupling of the circular area; r = 0 is omitted by the batch. The row i of the circle is in
+    // j₀ ≤ j ≤ j₁, the roots of |i a + j b|² = R² with a margin of one site.
+    const double ab = a.dot(b), a2 = a.squaredNorm(), b2 = b.squaredNorm();
+    for (int i = -2*R; i<2*R; i++) {
+        const double disc = sqr(i * ab) - b2 * (sqr(i) * a2 - sqr(R));
+        if (disc < 0) continue;
+        const int j0 = max(-2*R, int(floor((-i * ab - sqrt(disc)) / b2)) - 1);
+        const int j1 = min(2*R - 1, int(ceil((-i * ab + sqrt(disc)) / b2)) + 1);
+        for (int j = j0; j <= j1; j++)
+            batch.add(i * a + j * b);
+    }
+
+    const Matrix3d JTotal = batch.sum();
+    count = batch.count();
+    lout << "\nJₜ(R = " << R << "): [\n"
+         << fixed << setprecision(3) << JTotal.format(CSVFormat) << "]" << endl;
+
+    return JTotal(1,1);
+}
+
+// Following function calculates J_s(∞) of each site s of the cell of lat, and stores it in file as
+//   lattice, <id>, <sites>
+//   s, J₀₀, J₀₁, ..., J₂₂                   (one line for each site)
+// followed by the table of J_s(R).
+void Store_Jinf(const Lattice& lat, const char* file) {
+    lout << "\nEstimating J(∞) of the " << lat.id() << " lattice ..." << endl;
+
+    ofstream res(file,                      // The result of estimation
+                 std::ios_base::out | std::ios_base::trunc);
+
+    lout.start();                           // calculates the executing time of the
+                                            // main section of code.
+    const int n = lat.sites();
+    vector<Matrix3d> J(n * N);              // J[s N + i] = J_s(R = 10(i+1))
+    vector<int> count(n * N);
+    double Sx  = 0,                         // used for the linear fit
+           Sx2 = 0;
+
+    for (int i=0; i < N; i++) {
+        const double x = 1. / (10*(i+1));
+        Sx  += x / N;
+        Sx2 += sqr(x) / N;
+    }
+
+    res << "lattice, " << lat.id() << ", " << n << endl;
+    for (int s=0; s < n; s++) {
+        Matrix3d Sy  = Matrix3d::Zero(),
+                 Sxy = Matrix3d::Zero();
+        for (int i=0; i < N; i++) {
+            int R = 10*(i+1);
+            J[s*N + i] = estimation(R, count[s*N + i], lat, s);
+
+            Sxy += J[s*N + i] / (double(R) * N);
+            Sy  += J[s*N + i] / N;
+        }
+
+        // Each component is fitted separately.
+        const Matrix3d slope = ( Sxy - Sx*Sy ) / ( Sx2 - sqr(Sx) );
+        const Matrix3d intercept = Sy - slope * Sx;
+
+        lout << "\nJ_" << s << "(∞) = [\n" << fixed << setprecision(5) << intercept.format(CSVFormat) << "]\n" << endl
+             << resetiosflags(std::ios_base::floatfield | std::ios_base::showpoint)
+             << setprecision(-1);           // resets the stream format
+
+        res << s;
+        for (int k=0; k < 9; k++)
+            res << ", " << setprecision(9) << intercept(k / 3, k % 3);
+        res << endl;
+    }
+
+    res << "R, 1/R, s, N, J(R)" << endl;
+    for (int s=0; s < n; s++)
+        for (int i=0; i < N; i++) {
+            int R = 10*(i+1);
+            res << R << ", " << 1./R << ", " << s << ", " << count[s*N + i];
+            for (int k=0; k < 9; k++)
+                res << ", " << J[s*N + i](k / 3, k % 3);
+            res << '\n';
+        }
+    res.flush();
+
+    lout << "Finish estimating J(∞), ";
+    lout.stop();                            // calculates the executing time
+}
+
+// loads J_s(∞) of the sites of lat from file, which is written by Store_Jinf(lat, file).
+bool Load_Jinf(const Lattice& lat, const char* file, vector<Matrix3d>& J) {
+    ifstream in(file, std::ios_base::in);
+    string line, item;
+    if (!getline(in, line))
+        return false;
+
+    // lattice, <id>, <sites>
+    istringstream header(line);
+    string id;
+    int n = 0;
+    getline(header, item, ',');
+    getline(header >> ws, id, ',');
+    header >> n;
+    if ((item != "lattice") || (id != lat.id()) || (n != lat.sites()))
+        return false;
+
+    J.assign(n, Matrix3d::Zero());
+    for (int s=0; s < n; s++) {
+        if (!getline(in, line))
+            return false;
+        istringstream row(line);
+        getline(row, item, ',');            // s
+        for (int k=0; k < 9; k++) {
+            getline(row, item, ',');
+            J[s](k / 3, k % 3) = atof(item.c_str());
+        }
+    }
+    return true;
+}
+
+// Following function estimates J_s(R) of the site s of the cell of lat, i.e. the total coupling of the site s with
+// all sites in the circle of radius R, and count returns number of dipoles included in the estimation.
+Matrix3d estimation(int R, int& count, const Lattice& lat, int s) {
+    CouplingBatch batch(float(R) * R);      // the self-interaction is omitted by the batch.
+
+    // The cells (i, j) of the circle are in |i|, |j| ≤ M, where h is the shortest height of the cell.
+    const float area = lat.a.cross(lat.b).norm();
+    const float h = min(area / lat.a.norm(), area / lat.b.norm());
+    float reach = 0;
+    for (int k = 0; k < lat.sites(); k++)
+        reach = max(reach, (lat.site(k) - lat.site(s)).norm());
+    const int M = int(ceil((R + reach) / h));
+
+    for (int i = -M; i <= M; i++)
+        for (int j = -M; j <= M; j++)
+            for (int k = 0; k < lat.sites(); k++)
+                batch.add(i * lat.a + j * lat.b + lat.site(k) - lat.site(s));
+
+    count = batch.count();
+    return batch.sum();
+}
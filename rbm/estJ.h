@@ -1,25 +1,67 @@
-/***  Estimate the J(∞), Ver 1.00, Date: 22 May 2022 **************************
- ***                                                                        ***
- ***  Copyleft (ɔ) Nasim 2020-22, All lefts reserved!                       ***
- ***                                                                        ***
- ******************************************************************************
-
- * This code is under construction. It might contain some errors.
- * So you can try it at your own risk!
- */
-
-#ifndef ESTJ_H
-
-#define ESTJ_H
-
-#include <eigen3/Eigen/Dense>
-//#include <E:\code blocks\CodeBlocks\MinGW\include\eigen3\eigen-3.4.0\Eigen\Dense>
-
-//* The coupling dyadic between two dipoles with relative displacement r.
-Eigen::Matrix3f couplingJ(const Eigen::Vector3f& r);
-
-//* Following function gets the a and b as bases of the triangular Bravais lattice, and
-//* calculates the J(∞). Then stores it in the 1st line of J_inf.csv text file.
-void Store_Jinf(const Eigen::Vector3f& a, const Eigen::Vector3f& b);
-
-#endif
+/***  Estimate the J(∞), Ver 1.00, Date: 22 May 2022 **************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-22, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#ifndef ESTJ_H
+
+#define ESTJ_H
+
+#include <vector>
+#include <eigen3/Eigen/Dense>
+//#include <E:\code blocks\CodeBlocks\MinGW\include\eigen3\eigen-3.4.0\Eigen\Dense>
+
+//* The coupling dyadic between two dipoles with relative displacement r.
+Eigen::Matrix3f couplingJ(const Eigen::Vector3f& r);
+
+//* CouplingBatch sums the coupling dyadics of many displacements, e.g. of the images of a pair or of the sites of
+//* a circle. The displacements are gathered in SoA form (x[], y[], z[]), and each full batch is evaluated by a
+//* branch-free SIMD loop, where |r|⁻⁵ comes from 1/√|r|² and the sum is accumulated in double precision. Only the
+//* displacements with eps < |r|² ≤ r2Max are included; so the self-interaction is omitted as in couplingJ().
+class CouplingBatch {
+  public:
+    explicit CouplingBatch(float r2Max = 3.4e38f) : r2Max(r2Max) { clear(); }
+
+    void add(const Eigen::Vector3f& r) {
+        x[n] = r.x();
+        y[n] = r.y();
+        z[n] = r.z();
+        if (++n == size)
+            flush();
+    }
+
+    Eigen::Matrix3d sum();                  // Σ J(r) of the added displacements
+    long count();                           // number of the included displacements
+    void clear();                           // removes the displacements and the sum
+  private:
+    static const int size = 1024;
+    float x[size], y[size], z[size];
+    int n;                                  // number of the displacements of the current batch
+    float r2Max;
+    double S[6];                            // Σ Jxx, Jxy, Jxz, Jyy, Jyz, Jzz
+    long included;
+
+    void flush();                           // adds the current batch to S.
+};
+
+//* Following function gets the a and b as bases of the triangular Bravais lattice, and
+//* calculates the J(∞). Then stores it in the 1st line of J_inf.csv text file.
+void Store_Jinf(const Eigen::Vector3f& a, const Eigen::Vector3f& b);
+
+class Lattice;
+
+//* Following function calculates the tensor J_s(∞) = \lim_{R→∞} Σ_{|r| ≤ R} J(r) of each site s of the cell of lat,
+//* where r runs over the displacements of all sites of the lattice from the site s. Each component is
+//* extrapolated linearly in 1/R. Then stores the tensors in file; see Load_Jinf().
+void Store_Jinf(const Lattice& lat, const char* file);
+
+//* loads J_s(∞) of the sites of lat from file, which is written by Store_Jinf(lat, file). It returns false if
+//* file belongs to another lattice.
+bool Load_Jinf(const Lattice& lat, const char* file, std::vector<Eigen::Matrix3d>& J);
+
+#endif
@@ -0,0 +1,237 @@
+/***  Field terms, Ver 0.1, Date: 19 Oct 2026 **********************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * FieldPipeline<Terms...> composes the local field terms which are added to the total field Bₜ[i] of rbm.cpp in
+ * the same pass as the dipolar field, e.g.
+ *   typedef FieldPipeline<UniaxialAnisotropy<Real>, Exchange<Real> > Fields;
+ * The terms are unrolled at compile time; so an empty pipeline costs nothing, and the inner loop of the dipolar
+ * field is not touched by the terms. Each term has
+ *   void init(const FieldSetup& s);                    // initializes the term on the lattice of s
+ *   void field(int i, const Vec* mu, Vec& B) const;    // adds the field of the term on the site i to B [B⁎]
+ *   double energy(int i, const Vec* mu) const;         // energy of the site i [B⁎]; a bond is shared by its sites
+ *   double local(int i, const Vec* mu) const;          // all energy which depends on μᵢ, e.g. for Monte Carlo
+ *   void field(int i, const Vec* mu, const Real* m, Vec& B) const; // the same of the energy Σₖ mₖEₖ of the
+ *   double local(int i, const Vec* mu, const Real* m) const;       // moments mₖ (e.g. of POLYDISPERSE == 1)
+ *   static const char* name();
+ * where B = -∂E/∂μᵢ. The fields are in the unit of B⁎ like BDC, i.e. they are not scaled by λ. A term of one site
+ * is just multiplied by mᵢ in Σₖ mₖEₖ, but a bond ⟨ij⟩ is weighted by ½(mᵢ + mⱼ).
+ *   UniaxialAnisotropy   E = -K_u (μ·n)²
+ *   CubicAnisotropy      E = -K_c (μ_x⁴ + μ_y⁴ + μ_z⁴)
+ *   Exchange             E = -J Σ_⟨ij⟩ μᵢ·μⱼ over the pairs of the sites closer than r_ex (periodic in the plane)
+ *   SiteField            E = -μᵢ·hᵢ, where hᵢ = h(rᵢ)
+ */
+
+#ifndef FIELDS_H
+
+#define FIELDS_H
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include <eigen3/Eigen/Dense>
+
+struct FieldSetup {
+    int N;                                  // number of the sites
+    const Eigen::Vector3f* r;               // positions of the sites [l]
+    Eigen::Vector3f period1, period2;       // periods of the lattice in the plane, L a and L b [l]
+    float Ku;                               // uniaxial anisotropy [B⁎]
+    Eigen::Vector3f axis;                   // easy axis of the uniaxial anisotropy
+    float Kc;                               // cubic anisotropy [B⁎]
+    float Jex;                              // exchange coupling [B⁎]
+    float rex;                              // range of the exchange [l]
+    Eigen::Vector3f (*h)(const Eigen::Vector3f& r); // site field [B⁎]; NULL means zero
+};
+
+template <typename Real>
+class UniaxialAnisotropy {
+  public:
+    typedef Eigen::Matrix<Real, 3, 1> Vec;
+    void init(const FieldSetup& s) {
+        K = s.Ku;
+        n = s.axis.normalized().cast<Real>();
+    }
+    void field(int i, const Vec* mu, Vec& B) const { B += (2 * K * mu[i].dot(n)) * n; }
+    double energy(int i, const Vec* mu) const {
+        const double x = mu[i].dot(n);
+        return -K * x * x;
+    }
+    double local(int i, const Vec* mu) const { return energy(i, mu); }
+    void field(int i, const Vec* mu, const Real* m, Vec& B) const { B += (2 * K * m[i] * mu[i].dot(n)) * n; }
+    double local(int i, const Vec* mu, const Real* m) const { return m[i] * energy(i, mu); }
+    static const char* name() { return "uniaxial anisotropy"; }
+  private:
+    Real K;
+    Vec n;
+};
+
+template <typename Real>
+class CubicAnisotropy {
+  public:
+    typedef Eigen::Matrix<Real, 3, 1> Vec;
+    void init(const FieldSetup& s) { K = s.Kc; }
+    void field(int i, const Vec* mu, Vec& B) const {
+        B += (4 * K) * mu[i].cwiseProduct(mu[i]).cwiseProduct(mu[i]);
+    }
+    double energy(int i, const Vec* mu) const { return -K * mu[i].cwiseAbs2().squaredNorm(); }
+    double local(int i, const Vec* mu) const { return energy(i, mu); }
+    void field(int i, const Vec* mu, const Real* m, Vec& B) const {
+        B += (4 * K * m[i]) * mu[i].cwiseProduct(mu[i]).cwiseProduct(mu[i]);
+    }
+    double local(int i, const Vec* mu, const Real* m) const { return m[i] * energy(i, mu); }
+    static const char* name() { return "cubic anisotropy"; }
+  private:
+    Real K;
+};
+
+template <typename Real>
+class Exchange {
+  public:
+    typedef Eigen::Matrix<Real, 3, 1> Vec;
+    void init(const FieldSetup& s) { // finds the neighbors of each site by the nearest periodic image
+        J = s.Jex;
+        const float r2 = s.rex * s.rex * (1 + 1e-4);
+        first.assign(1, 0);
+        neighbor.clear();
+        for (int i = 0; i < s.N; i++) {
+            for (int j = 0; j < s.N; j++) {
+                if (j == i)
+                    continue;
+                bool near = false;
+                for (int k = -1; k <= 1; k++)
+                    for (int l = -1; l <= 1; l++)
+                        near = near || ((s.r[j] - s.r[i] + k * s.period1 + l * s.period2).squaredNorm() <= r2);
+                if (near)
+                    neighbor.push_back(j);
+            }
+            first.push_back(neighbor.size());
+        }
+    }
+    void field(int i, const Vec* mu, Vec& B) const { B += J * sum(i, mu); }
+    double energy(int i, const Vec* mu) const { return -0.5 * J * mu[i].dot(sum(i, mu)); }
+    double local(int i, const Vec* mu) const { return -J * mu[i].dot(sum(i, mu)); } // the whole bonds of i
+    void field(int i, const Vec* mu, const Real* m, Vec& B) const { B += J * sum(i, mu, m); }
+    double local(int i, const Vec* mu, const Real* m) const { return -J * mu[i].dot(sum(i, mu, m)); }
+    static const char* name() { return "exchange"; }
+  private:
+    Real J;
+    std::vector<int> first, neighbor;       // the neighbors of the site i are neighbor[first[i] ... first[i+1])
+    Vec sum(int i, const Vec* mu) const {
+        Vec S = Vec::Zero();
+        for (int k = first[i]; k < first[i + 1]; k++)
+            S += mu[neighbor[k]];
+        return S;
+    }
+    Vec sum(int i, const Vec* mu, const Real* m) const { // Σⱼ ½(mᵢ + mⱼ) μⱼ
+        Vec S = Vec::Zero();
+        for (int k = first[i]; k < first[i + 1]; k++)
+            S += (0.5 * (m[i] + m[neighbor[k]])) * mu[neighbor[k]];
+        return S;
+    }
+};
+
+template <typename Real>
+class SiteField {
+  public:
+    typedef Eigen::Matrix<Real, 3, 1> Vec;
+    void init(const FieldSetup& s) {
+        h.resize(s.N);
+        for (int i = 0; i < s.N; i++)
+            h[i] = s.h ? Vec(s.h(s.r[i]).template cast<Real>()) : Vec(Vec::Zero());
+    }
+    void field(int i, const Vec* mu, Vec& B) const { B += h[i]; }
+    double energy(int i, const Vec* mu) const { return -mu[i].dot(h[i]); }
+    double local(int i, const Vec* mu) const { return energy(i, mu); }
+    void field(int i, const Vec* mu, const Real* m, Vec& B) const { B += m[i] * h[i]; }
+    double local(int i, const Vec* mu, const Real* m) const { return m[i] * energy(i, mu); }
+    static const char* name() { return "site field"; }
+  private:
+    std::vector<Vec, Eigen::aligned_allocator<Vec> > h;
+};
+
+template <typename... Terms>
+class FieldPipeline {
+  public:
+    static const int size = sizeof...(Terms);
+
+    void init(const FieldSetup& s) { Each<0>::init(terms, s); }
+
+    // adds the fields of all terms on the site i to B.
+    template <typename Vec>
+    void field(int i, const Vec* mu, Vec& B) const { Each<0>::field(terms, i, mu, B); }
+
+    // total energy of the terms on the site i
+    template <typename Vec>
+    double energy(int i, const Vec* mu) const { return Each<0>::energy(terms, i, mu); }
+
+    // all energy of the terms which depends on μᵢ
+    template <typename Vec>
+    double local(int i, const Vec* mu) const { return Each<0>::local(terms, i, mu); }
+
+    // the same of the energy Σₖ mₖEₖ of the moments m
+    template <typename Vec, typename W>
+    void field(int i, const Vec* mu, const W* m, Vec& B) const { Each<0>::field(terms, i, mu, m, B); }
+    template <typename Vec, typename W>
+    double local(int i, const Vec* mu, const W* m) const { return Each<0>::local(terms, i, mu, m); }
+
+    std::string names() const { return Each<0>::names(); }
+  private:
+    typedef std::tuple<Terms...> Tuple;
+    Tuple terms;
+
+    template <int k, bool end = (k == size)>
+    struct Each {                           // the terms k, k+1, ...
+        static void init(Tuple& t, const FieldSetup& s) {
+            std::get<k>(t).init(s);
+            Each<k + 1>::init(t, s);
+        }
+        template <typename Vec>
+        static void field(const Tuple& t, int i, const Vec* mu, Vec& B) {
+            std::get<k>(t).field(i, mu, B);
+            Each<k + 1>::field(t, i, mu, B);
+        }
+        template <typename Vec>
+        static double energy(const Tuple& t, int i, const Vec* mu) {
+            return std::get<k>(t).energy(i, mu) + Each<k + 1>::energy(t, i, mu);
+        }
+        template <typename Vec>
+        static double local(const Tuple& t, int i, const Vec* mu) {
+            return std::get<k>(t).local(i, mu) + Each<k + 1>::local(t, i, mu);
+        }
+        template <typename Vec, typename W>
+        static void field(const Tuple& t, int i, const Vec* mu, const W* m, Vec& B) {
+            std::get<k>(t).field(i, mu, m, B);
+            Each<k + 1>::field(t, i, mu, m, B);
+        }
+        template <typename Vec, typename W>
+        static double local(const Tuple& t, int i, const Vec* mu, const W* m) {
+            return std::get<k>(t).local(i, mu, m) + Each<k + 1>::local(t, i, mu, m);
+        }
+        static std::string names() {
+            const std::string rest = Each<k + 1>::names();
+            return std::string(std::tuple_element<k, Tuple>::type::name()) + (rest.empty() ? "" : ", " + rest);
+        }
+    };
+    template <int k>
+    struct Each<k, true> {                  // after the last term
+        static void init(Tuple&, const FieldSetup&) {}
+        template <typename Vec>
+        static void field(const Tuple&, int, const Vec*, Vec&) {}
+        template <typename Vec>
+        static double energy(const Tuple&, int, const Vec*) { return 0; }
+        template <typename Vec>
+        static double local(const Tuple&, int, const Vec*) { return 0; }
+        template <typename Vec, typename W>
+        static void field(const Tuple&, int, const Vec*, const W*, Vec&) {}
+        template <typename Vec, typename W>
+        static double local(const Tuple&, int, const Vec*, const W*) { return 0; }
+        static std::string names() { return ""; }
+    };
+};
+
+#endif
@@ -0,0 +1,160 @@
+/***  Field tracker, Ver 0.1, Date: 19 Oct 2026 ********************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * FieldTracker keeps the fields Bᵢ = Σⱼ J[i][j] sⱼ of n sources up to date while the sources change one (or a
+ * few) at a time, e.g. in the moves of a Monte Carlo sweep. The couplings of the dipoles are symmetric,
+ * J[i][j] == J[j][i], so a change Δsⱼ adds J[j][i] Δsⱼ to each Bᵢ: a pass over the contiguous row j instead of
+ * the N² products of a full calculation. The rounding errors of the updates accumulate; so the fields are
+ * calculated again from the sources (refreshed) after each interval updates.
+ *
+ * The tracker keeps its own copy of the sources which its fields belong to. sync(s) compares it with s and
+ * applies the differences, e.g. after a realization starts or a global update moves all sources; so the owner
+ * does not need to report the changes that are not made by move().
+ *
+ * A pass of a row for each move is as expensive as the row sum of the field that it replaces. So the moves of a
+ * sampler are staged instead: stage() keeps up to block changes, field(i) adds their couplings to Bᵢ (a few
+ * products), and flush() adds all of them in one pass, where the rows are streamed over chunks of the fields and
+ * the chunks are updated in parallel.
+ *
+ * Coupling is the stored type of J[i][j], which is multiplied by Vec (e.g. JStore of rbm.cpp), and VecF is the
+ * type of the fields; the fields are accumulated in VecF.
+ */
+
+#ifndef FIELDTRACK_H
+
+#define FIELDTRACK_H
+
+#include <algorithm>
+#include <vector>
+
+template <typename Coupling, typename Vec, typename VecF>
+class FieldTracker {
+  public:
+    long updates, refreshes;                // numbers of the updated rows and the full calculations
+
+    FieldTracker() : updates(0), refreshes(0), J(0), n(0), interval(0), age(0), block(1), valid(false) {}
+
+    // tracks the fields of the couplings J[0 ... n-1][0 ... n-1], which are refreshed after interval updates; up
+    // to block changes are staged.
+    void init(Coupling** J, int n, long interval, int block = 1) {
+        this->J = J;
+        this->n = n;
+        this->interval = interval;
+        this->block = block;
+        B.assign(n, VecF::Zero());
+        s.assign(n, Vec::Zero());
+        staged.clear();
+        stagedS.clear();
+        valid = false;
+    }
+
+    const VecF& operator[](int i) const { return B[i]; } // the field without the staged changes
+
+    VecF field(int i) const {               // the field with the staged changes
+        VecF Bi = B[i];
+        for (size_t c = 0; c < staged.size(); c++) {
+            const Vec d = stagedS[c] - s[staged[c]]; // a concrete Vec for the packed couplings
+            Bi += (J[staged[c]][i] * d).template cast<typename VecF::Scalar>();
+        }
+        return Bi;
+    }
+
+    void stage(int j, const Vec& s1) {      // the source j is changed to s1; the block is flushed if it is full.
+        for (size_t c = 0; c < staged.size(); c++)
+            if (staged[c] == j) {
+                stagedS[c] = s1;
+                return;
+            }
+        staged.push_back(j);
+        stagedS.push_back(s1);
+        if (int(staged.size()) >= block)
+            flush();
+    }
+
+    void flush() {                          // adds the staged changes to the fields.
+        if (staged.empty())
+            return;
+        move(&staged[0], &stagedS[0], staged.size());
+        staged.clear();
+        stagedS.clear();
+    }
+
+    void invalidate() { valid = false; }    // the fields are refreshed by the next sync(), e.g. if J is changed.
+
+    // brings the fields to the sources s[0 ... n-1]; they are refreshed if more than n/2 sources are changed.
+    void sync(const Vec* s1) {
+        flush();
+        std::vector<int> j;
+        std::vector<Vec> sj;
+        if (valid && (age < interval))
+            for (int k = 0; k < n; k++)
+                if (s1[k] != s[k]) {
+                    j.push_back(k);
+                    sj.push_back(s1[k]);
+                }
+        if (!valid || (age >= interval) || (2 * int(j.size()) > n))
+            refresh(s1);
+        else if (!j.empty())
+            move(&j[0], &sj[0], j.size());
+    }
+
+    void move(int j, const Vec& s1) { move(&j, &s1, 1); } // the source j is changed to s1.
+
+    // the sources j[0 ... k-1] are changed to s1[0 ... k-1]; the fields are updated in one pass over them.
+    void move(const int* j, const Vec* s1, int k) {
+        std::vector<Vec> ds(k);
+        for (int c = 0; c < k; c++) {
+            ds[c] = s1[c] - s[j[c]];
+            s[j[c]] = s1[c];
+        }
+        // Each row j[c] is read in order over a chunk of the fields, which stays in the cache for all k rows.
+        #pragma omp parallel for schedule(static) if (long(n) * k >= parallelWork)
+        for (int i0 = 0; i0 < n; i0 += chunk) {
+            const int i1 = std::min(n, i0 + chunk);
+            for (int c = 0; c < k; c++) {
+                const Coupling* Jc = J[j[c]];
+                const Vec d = ds[c];
+                for (int i = i0; i < i1; i++)
+                    B[i] += (Jc[i] * d).template cast<typename VecF::Scalar>();
+            }
+        }
+        updates += k;
+        age += k;
+    }
+
+    void refresh(const Vec* s1) {           // calculates the fields of the sources s1 again.
+        for (int j = 0; j < n; j++)
+            s[j] = s1[j];
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; i++) {
+            VecF Bi = VecF::Zero();
+            for (int j = 0; j < n; j++)
+                Bi += (J[i][j] * s[j]).template cast<typename VecF::Scalar>();
+            B[i] = Bi;
+        }
+        refreshes++;
+        age = 0;
+        valid = true;
+    }
+  private:
+    static const int chunk = 256;           // fields of a chunk of move()
+    static const long parallelWork = 1L << 14; // products of a move() which are worth a parallel region
+    Coupling** J;
+    int n;
+    long interval;
+    long age;                               // number of the updates since the last refresh
+    int block;                              // maximum number of the staged changes
+    bool valid;
+    std::vector<VecF> B;                    // the tracked fields
+    std::vector<Vec> s;                     // the sources of B
+    std::vector<int> staged;                // the staged changes: the sources staged[c] are changed to stagedS[c].
+    std::vector<Vec> stagedS;
+};
+
+#endif
@@ -0,0 +1,92 @@
+/***  Energy histogram, Ver 0.1, Date: 19 Oct 2026 *****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <math.h>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include "histogram.h"
+
+using namespace std;
+
+HistogramBin& HistogramBin::operator+=(const HistogramBin& b) {
+    count += b.count;
+    sE  += b.sE;
+    sM  += b.sM;
+    sM2 += b.sM2;
+    sM4 += b.sM4;
+    return *this;
+}
+
+EnergyHistogram::EnergyHistogram(double dE) : N(0), lambda(0), dE(dE) {
+    B[0] = B[1] = B[2] = 0;
+    init();
+}
+
+void EnergyHistogram::init() {              // removes all samples.
+    samples = 0;
+    bins.clear();
+}
+
+void EnergyHistogram::sample(double e, double M2) { // gets a sample of the energy per dipole e and |M|².
+    HistogramBin& b = bins[long(floor(e / dE))];
+    b.count++;
+    b.sE  += e;
+    b.sM  += sqrt(M2);
+    b.sM2 += M2;
+    b.sM4 += M2 * M2;
+    samples++;
+}
+
+void EnergyHistogram::write(ostream& os) const { // exports the histogram as a block of the text stream.
+    if (samples == 0)
+        return;
+
+    os << "# N " << N << " lambda " << setprecision(9) << lambda
+       << " B " << B[0] << ' ' << B[1] << ' ' << B[2]
+       << " dE " << dE << " samples " << samples << '\n'
+       << setprecision(12);
+
+    for (map<long, HistogramBin>::const_iterator it = bins.begin(); it != bins.end(); ++it) {
+        const HistogramBin& b = it->second;
+        os << it->first << ' ' << b.count << ' ' << b.sE << ' ' << b.sM << ' ' << b.sM2 << ' ' << b.sM4 << '\n';
+    }
+    os << endl;
+}
+
+bool EnergyHistogram::read(istream& is) { // reads the next block of the text stream; false at the end.
+    init();
+
+    string line;
+    do {                                    // finds the header of the block
+        if (!getline(is, line))
+            return false;
+    } while (line.empty() || line[0] != '#');
+
+    istringstream header(line.substr(1));
+    string key;
+    while (header >> key) {
+        if      (key == "N")       header >> N;
+        else if (key == "lambda")  header >> lambda;
+        else if (key == "B")       header >> B[0] >> B[1] >> B[2];
+        else if (key == "dE")      header >> dE;
+        else if (key == "samples") header >> samples;
+    }
+
+    while (getline(is, line) && !line.empty()) {
+        istringstream data(line);
+        long i;
+        HistogramBin b;
+        if (data >> i >> b.count >> b.sE >> b.sM >> b.sM2 >> b.sM4)
+            bins[i] += b;
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+/***  Energy histogram, Ver 0.1, Date: 19 Oct 2026 *****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * EnergyHistogram records the histogram of the magnetic energy per dipole e (magEnergy()) at a fixed λ. Each
+ * energy bin also keeps the summations of e, |M|, |M|² and |M|⁴ of its samples; so the joint distribution of
+ * (e, |M|², |M|⁴) is kept exactly as far as the moments are concerned, while only the non-empty bins are
+ * stored. These histograms are the inputs of the multi-histogram reweighting of reweight.cpp.
+ *
+ * A histogram is exported as a block of a text stream:
+ *   # N <number of dipoles> lambda <λ> B <Bx> <By> <Bz> dE <bin width> samples <number of samples>
+ *   <bin index> <count> <Σe> <Σ|M|> <Σ|M|²> <Σ|M|⁴>
+ *   ...
+ *   <empty line>
+ */
+
+#ifndef HISTOGRAM_H
+
+#define HISTOGRAM_H
+
+#include <iostream>
+#include <map>
+
+struct HistogramBin {                       // an energy bin
+    long   count;                           // number of samples
+    double sE,                              // Σe
+           sM,                              // Σ|M|
+           sM2,                             // Σ|M|²
+           sM4;                             // Σ|M|⁴
+    HistogramBin() : count(0), sE(0), sM(0), sM2(0), sM4(0) {}
+    HistogramBin& operator+=(const HistogramBin& b);
+};
+
+class EnergyHistogram {
+  public:
+    int    N;                               // number of dipoles
+    double lambda;                          // λ of the samples
+    double B[3];                            // DC part of the external magnetic field
+    double dE;                              // width of the energy bins
+    long   samples;                         // number of samples
+    std::map<long, HistogramBin> bins;      // non-empty bins
+
+    EnergyHistogram(double dE = 1e-4);
+    void init();                            // removes all samples.
+    void sample(double e, double M2);       // gets a sample of the energy per dipole e and |M|².
+    void write(std::ostream& os) const;     // exports the histogram as a block of the text stream.
+    bool read(std::istream& is);            // reads the next block of the text stream; false at the end.
+};
+
+#endif
@@ -0,0 +1,71 @@
+/***  Lattice geometry, Ver 0.1, Date: 19 Oct 2026 *****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <math.h>
+#include "lattice.h"
+
+using namespace std;
+using namespace Eigen;
+
+Lattice::Lattice(const string& name, const Vector3f& a, const Vector3f& b)
+    : a(a), b(b), c(0, 0, 1), basis(1, Vector3f::Zero()), layers(1), name(name) {}
+
+Lattice& Lattice::add(const Vector3f& site) { // adds a site to the basis of the cell
+    basis.push_back(site);
+    return *this;
+}
+
+Lattice& Lattice::stack(int layers, const Vector3f& c) { // stacks the layers
+    this->layers = layers;
+    this->c = c;
+    return *this;
+}
+
+Vector3f Lattice::site(int s) const { // position of the site s in the cell
+    const int nb = basis.size();
+    return basis[s % nb] + (s / nb) * c;
+}
+
+bool Lattice::legacy() const { // the lattice of J_inf.csv
+    return (name == "triangular") && (basis.size() == 1) && (layers == 1);
+}
+
+string Lattice::id() const { // e.g. honeycomb or honeycomb_2 for a bilayer
+    return (layers > 1) ? name + "_" + to_string(layers) : name;
+}
+
+Lattice Lattice::triangular() {
+    return Lattice("triangular", Vector3f(1, 0, 0), Vector3f(0.5, 0.5 * sqrt(3), 0));
+}
+
+Lattice Lattice::square() {
+    return Lattice("square", Vector3f(1, 0, 0), Vector3f(0, 1, 0));
+}
+
+Lattice Lattice::honeycomb() { // two sites in the cell of a triangular lattice with a = √3
+    return Lattice("honeycomb", Vector3f(sqrt(3), 0, 0), Vector3f(0.5 * sqrt(3), 1.5, 0))
+           .add(Vector3f(0, 1, 0));
+}
+
+Lattice Lattice::kagome() { // three sites in the cell of a triangular lattice with a = 2
+    return Lattice("kagome", Vector3f(2, 0, 0), Vector3f(1, sqrt(3), 0))
+           .add(Vector3f(1, 0, 0))
+           .add(Vector3f(0.5, 0.5 * sqrt(3), 0));
+}
+
+Lattice Lattice::byIndex(int index) { // 0: triangular, 1: square, 2: honeycomb, 3: kagome
+    switch (index) {
+        case 1:  return square();
+        case 2:  return honeycomb();
+        case 3:  return kagome();
+        default: return triangular();
+    }
+}
@@ -0,0 +1,55 @@
+/***  Lattice geometry, Ver 0.1, Date: 19 Oct 2026 *****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * Lattice describes the geometry of the unit cell of rbm.cpp: a 2D Bravais lattice with the bases a and b, a basis
+ * of nb sites in the cell, and a stack of layers which are displaced by c. The site s = layer nb + k of the cell
+ * (i, j) is at
+ *   i a + j b + basis[k] + layer c,
+ * and it has the index (i L + j) sites() + s in the L x L unit cell; so the sites of each sublattice s form an
+ * L x L Bravais lattice with offset s and stride sites(), which is the layout of SpinCorrelation::compute() and
+ * topology(). The lattice is periodic only in the plane of a and b.
+ * The default lattice (triangular, one site, one layer) is the lattice of the legacy J_inf.csv.
+ */
+
+#ifndef LATTICE_H
+
+#define LATTICE_H
+
+#include <string>
+#include <vector>
+#include <eigen3/Eigen/Dense>
+
+class Lattice {
+  public:
+    Eigen::Vector3f a, b;                   // Bases of the Bravais lattice [l]
+    Eigen::Vector3f c;                      // displacement of the adjacent layers [l]
+    std::vector<Eigen::Vector3f> basis;     // positions of the sites in the cell of a layer [l]
+    int layers;                             // number of the layers of the stack
+    std::string name;
+
+    // a Bravais lattice with one site at the origin and one layer
+    Lattice(const std::string& name, const Eigen::Vector3f& a, const Eigen::Vector3f& b);
+
+    Lattice& add(const Eigen::Vector3f& site); // adds a site to the basis of the cell
+    Lattice& stack(int layers, const Eigen::Vector3f& c); // stacks the layers
+
+    int sites() const { return int(basis.size()) * layers; } // number of the sites of the cell
+    Eigen::Vector3f site(int s) const;      // position of the site s in the cell [l]
+    bool legacy() const;                    // the lattice of J_inf.csv, where J(∞) = diag(J₁₁, J₁₁, -2J₁₁)
+    std::string id() const;                 // e.g. honeycomb or honeycomb_2 for a bilayer
+
+    // The lattices of the LATTICE switch of rbm.cpp; the nearest neighbors are at the distance l.
+    static Lattice triangular();
+    static Lattice square();
+    static Lattice honeycomb();
+    static Lattice kagome();
+    static Lattice byIndex(int index);      // 0: triangular, 1: square, 2: honeycomb, 3: kagome
+};
+
+#endif
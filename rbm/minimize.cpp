@@ -0,0 +1,139 @@
+/***  Minimizer on spheres, Ver 0.1, Date: 19 Oct 2026 *************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <algorithm>
+#include <deque>
+#include <math.h>
+#include "minimize.h"
+
+using namespace std;
+using namespace Eigen;
+
+MinimizeResult SphereLBFGS::minimize(Vector3d* x, int n, Objective f, double tol, int maxIterations) const {
+
+    Field g(n), d(n), xNew(n), gNew(n), q(n);
+    deque<Field> S, Y;                      // the last pairs s = Δx and y = Δg, the newest at the front
+    deque<double> rho;                      // 1/(s·y)
+
+    MinimizeResult R = {0, 0, 0, 0, false};
+    R.E = f(x, &g[0]);
+    R.evaluations = 1;
+    project(x, g);
+
+    for (R.iterations = 0; R.iterations < maxIterations; R.iterations++) {
+        R.torque = maxNorm(g);
+        if (R.torque < tol) {
+            R.converged = true;
+            break;
+        }
+
+        // two-loop recursion; the initial Hessian is γ I, where γ = s·y/y·y of the newest pair.
+        q = g;
+        vector<double> a(S.size());
+        for (size_t k = 0; k < S.size(); k++) {
+            a[k] = rho[k] * dot(S[k], q);
+            for (int i = 0; i < n; i++)
+                q[i] -= a[k] * Y[k][i];
+        }
+        const double gamma = S.empty() ? firstAngle / R.torque : 1 / (rho[0] * dot(Y[0], Y[0]));
+        for (int i = 0; i < n; i++)
+            q[i] *= gamma;
+        for (size_t k = S.size(); k-- > 0; ) {
+            const double b = rho[k] * dot(Y[k], q);
+            for (int i = 0; i < n; i++)
+                q[i] += (a[k] - b) * S[k][i];
+        }
+        for (int i = 0; i < n; i++)
+            d[i] = -q[i];
+        project(x, d);
+
+        double slope = dot(g, d);
+        if (slope >= 0) {                   // not a descent direction; the memory is reset.
+            S.clear();
+            Y.clear();
+            rho.clear();
+            for (int i = 0; i < n; i++)
+                d[i] = -(firstAngle / R.torque) * g[i];
+            slope = dot(g, d);
+        }
+
+        // Armijo backtracking on the retraction
+        double alpha = 1, E = 0;
+        bool accepted = false;
+        for (int k = 0; k < 40; k++, alpha *= 0.5) {
+            for (int i = 0; i < n; i++)
+                xNew[i] = (x[i] + alpha * d[i]).normalized();
+            E = f(&xNew[0], &gNew[0]);
+            R.evaluations++;
+            if (E <= R.E + 1e-4 * alpha * slope + resolution * fabs(R.E)) {
+                accepted = true;
+                break;
+            }
+        }
+        if (!accepted) {                    // stalled, e.g. at the resolution of the energy
+            if (S.empty())
+                break;
+            S.clear();
+            Y.clear();
+            rho.clear();
+            continue;
+        }
+
+        // the new pair and the old pairs on the tangent planes of the new point
+        project(&xNew[0], gNew);
+        Field s(n), y(n);
+        for (int i = 0; i < n; i++) {
+            s[i] = xNew[i] - x[i];
+            y[i] = gNew[i] - g[i];
+        }
+        project(&xNew[0], s);
+        project(&xNew[0], y);
+        for (size_t k = 0; k < S.size(); k++) {
+            project(&xNew[0], S[k]);
+            project(&xNew[0], Y[k]);
+        }
+        const double sy = dot(s, y);
+        if (sy > 1e-12 * dot(s, s)) {
+            S.push_front(s);
+            Y.push_front(y);
+            rho.push_front(1 / sy);
+            if (int(S.size()) > memory) {
+                S.pop_back();
+                Y.pop_back();
+                rho.pop_back();
+            }
+        }
+
+        copy(xNew.begin(), xNew.end(), x);
+        g = gNew;
+        R.E = E;
+    }
+    R.torque = maxNorm(g);
+    return R;
+}
+
+double SphereLBFGS::dot(const Field& u, const Field& v) {
+    double s = 0;
+    for (size_t i = 0; i < u.size(); i++)
+        s += u[i].dot(v[i]);
+    return s;
+}
+
+double SphereLBFGS::maxNorm(const Field& u) {
+    double m = 0;
+    for (size_t i = 0; i < u.size(); i++)
+        m = max(m, u[i].norm());
+    return m;
+}
+
+void SphereLBFGS::project(const Vector3d* x, Field& u) { // projects u on the tangent planes of x
+    for (size_t i = 0; i < u.size(); i++)
+        u[i] -= x[i].dot(u[i]) * x[i];
+}
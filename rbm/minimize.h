@@ -0,0 +1,58 @@
+/***  Minimizer on spheres, Ver 0.1, Date: 19 Oct 2026 *************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * SphereLBFGS minimizes an energy E(x₀, ..., xₙ₋₁) of n unit vectors, i.e. on the product of n spheres, by the
+ * Riemannian L-BFGS method:
+ *   - the gradient of each site is projected on the tangent plane of its sphere, gᵢ - (xᵢ·gᵢ) xᵢ, and the
+ *     maximum norm of the projected gradients (the torque) is the measure of the convergence;
+ *   - the direction is found by the two-loop recursion of the last pairs (s, y), which are moved to the tangent
+ *     planes of the new point by the projection;
+ *   - a step is the retraction xᵢ ← (xᵢ + α dᵢ)/|xᵢ + α dᵢ| with the Armijo backtracking on α.
+ * The memory is reset if the direction is not a descent direction, and the first step rotates the sites by at
+ * most firstAngle. The energies of a float state are resolved only to a relative error of resolution; so the
+ * Armijo condition allows an increase of resolution |E|, and the minimization stops if even the steepest step
+ * does not satisfy it.
+ */
+
+#ifndef MINIMIZE_H
+
+#define MINIMIZE_H
+
+#include <vector>
+#include <eigen3/Eigen/Dense>
+
+struct MinimizeResult {
+    double E;                               // energy of the last point
+    double torque;                          // maximum norm of the projected gradients
+    int iterations, evaluations;
+    bool converged;                         // the torque is less than the tolerance.
+};
+
+class SphereLBFGS {
+  public:
+    // returns E(x) and its gradient g = ∂E/∂x; the gradient does not need to be projected.
+    typedef double (*Objective)(const Eigen::Vector3d* x, Eigen::Vector3d* g);
+
+    SphereLBFGS(double resolution = 0, int memory = 8, double firstAngle = 0.1)
+        : resolution(resolution), memory(memory), firstAngle(firstAngle) {}
+
+    // minimizes f from the point x[0 ... n-1] (|xᵢ| == 1), which is replaced by the minimum.
+    MinimizeResult minimize(Eigen::Vector3d* x, int n, Objective f, double tol, int maxIterations) const;
+  private:
+    typedef std::vector<Eigen::Vector3d> Field;
+    double resolution;                      // relative error of the energies
+    int memory;
+    double firstAngle;                      // maximum rotation of the first step [rad]
+
+    static double dot(const Field& u, const Field& v);
+    static double maxNorm(const Field& u);
+    static void project(const Eigen::Vector3d* x, Field& u); // projects u on the tangent planes of x
+};
+
+#endif
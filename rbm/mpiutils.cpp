@@ -0,0 +1,100 @@
+/***  MPI utilities, Ver 0.1, Date: 19 Oct 2026 ********************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#ifdef USE_MPI
+  #include <mpi.h>
+#endif
+#include "mpiutils.h"
+#include "utils.h"
+
+using namespace std;
+
+int mpiRank = 0;                            // rank of this process
+int mpiSize = 1;                            // number of processes
+int mpiLocalSize = 1;                       // number of processes on this machine
+
+void init_mpiutils(int* argc, char*** argv) {
+    #ifdef USE_MPI
+        MPI_Init(argc, argv);
+        MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+        MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+
+        // the ranks which share the memory of this machine
+        MPI_Comm local;
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, mpiRank, MPI_INFO_NULL, &local);
+        MPI_Comm_size(local, &mpiLocalSize);
+        MPI_Comm_free(&local);
+
+        if (mpiRank > 0) {
+            lout.open(("log" + to_string(mpiRank) + ".txt").c_str());
+            lout.echo(false);
+        }
+    #endif
+}
+
+void free_mpiutils() {
+    #ifdef USE_MPI
+        MPI_Finalize();
+    #endif
+}
+
+void mpiBarrier() {
+    #ifdef USE_MPI
+        MPI_Barrier(MPI_COMM_WORLD);
+    #endif
+}
+
+void mpiBlock(int n, int& begin, int& end) { // the block [begin, end) of n items of this rank
+    begin = int(long(n) * mpiRank / mpiSize);
+    end   = int(long(n) * (mpiRank + 1) / mpiSize);
+}
+
+void mpiAllgatherRows(double* data, int n, int rowSize) { // copies the rows of the blocks to all ranks.
+    #ifdef USE_MPI
+        if (mpiSize == 1)
+            return;
+        vector<int> counts(mpiSize), displs(mpiSize);
+        for (int k = 0; k < mpiSize; k++) {
+            const int begin = int(long(n) * k / mpiSize), end = int(long(n) * (k + 1) / mpiSize);
+            counts[k] = (end - begin) * rowSize;
+            displs[k] = begin * rowSize;
+        }
+        MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                       data, &counts[0], &displs[0], MPI_DOUBLE, MPI_COMM_WORLD);
+    #endif
+}
+
+vector<string> mpiGather(const string& s) { // gathers s of all ranks in rank 0.
+    #ifdef USE_MPI
+        int size = s.size();
+        vector<int> sizes(mpiSize), displs(mpiSize);
+        MPI_Gather(&size, 1, MPI_INT, &sizes[0], 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+        int total = 0;
+        for (int k = 0; k < mpiSize; k++) {
+            displs[k] = total;
+            total += sizes[k];
+        }
+        vector<char> buffer(max(total, 1));
+        MPI_Gatherv(const_cast<char*>(s.data()), size, MPI_CHAR,
+                    &buffer[0], &sizes[0], &displs[0], MPI_CHAR, 0, MPI_COMM_WORLD);
+
+        vector<string> parts;
+        if (mpiRank == 0)
+            for (int k = 0; k < mpiSize; k++)
+                parts.push_back(string(&buffer[displs[k]], sizes[k]));
+        return parts;
+    #else
+        return vector<string>(1, s);
+    #endif
+}
@@ -0,0 +1,44 @@
+/***  MPI utilities, Ver 0.1, Date: 19 Oct 2026 ********************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * A thin layer over MPI for distributing the realizations and the calculation of the couplings over several
+ * processes (ranks), which may be on different machines. Without USE_MPI (or -DUSE_MPI of mpicxx), the routines
+ * act as a single rank; so the calling code does not need any #ifdef.
+ *
+ * MPI Note:
+ *   Code should be compiled by mpicxx with -DUSE_MPI (make mpi) and run by mpirun, e.g.
+ *     mpirun -np 4 ./rbm
+ *   on a single machine for testing, or with a hostfile on a cluster.
+ */
+
+#ifndef MPIUTILS_H
+
+#define MPIUTILS_H
+
+#include <string>
+#include <vector>
+
+extern int mpiRank;                         // rank of this process
+extern int mpiSize;                         // number of processes
+extern int mpiLocalSize;                    // number of processes on this machine
+
+void init_mpiutils(int* argc, char*** argv);// Initialize MPI. The ranks > 0 write their logs to log<rank>.txt
+                                            // without echo. It should be executed before init_mtutils().
+void free_mpiutils();                       // Finalize MPI
+
+void mpiBarrier();
+// the block [begin, end) of n items of this rank
+void mpiBlock(int n, int& begin, int& end);
+// data[] is n rows of rowSize doubles, where the rows of mpiBlock(n) of each rank are valid; then all rows are
+// copied to all ranks.
+void mpiAllgatherRows(double* data, int n, int rowSize);
+// gathers s of all ranks in rank 0; the other ranks get an empty vector.
+std::vector<std::string> mpiGather(const std::string& s);
+
+#endif
@@ -0,0 +1,134 @@
+/***  NUMA replicas, Ver 0.1, Date: 19 Oct 2026 ********************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * On a multi-socket machine, the memory of an array is placed on the NUMA node of the thread which first writes
+ * it (first touch). If the rows of the lattice are always processed by the same threads with a static schedule,
+ * their couplings stay in the memory of their own socket. However, each row needs the orientations of the whole
+ * lattice; so PlaceReplica keeps a copy of such an array for each OpenMP place (e.g. a socket with
+ * OMP_PLACES=sockets). In each step, the threads of a place copy their slab of the array into the replica of
+ * their place, and then they only read their local replica. So the traffic between the sockets is limited to
+ * one copy of the array per place and step.
+ *
+ * The threads must be bound to the places, e.g.
+ *   OMP_PLACES=sockets OMP_PROC_BIND=close ./rbm -numa
+ * Without the places (or OpenMP), there is one replica.
+ */
+
+#ifndef NUMA_H
+
+#define NUMA_H
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+inline int placeNum() {                     // place of the calling thread; 0 without the places
+    #ifdef _OPENMP
+        return (omp_get_num_places() > 0) ? omp_get_place_num() : 0;
+    #else
+        return 0;
+    #endif
+}
+
+inline int threadNum() {
+    #ifdef _OPENMP
+        return omp_get_thread_num();
+    #else
+        return 0;
+    #endif
+}
+
+inline int threadCount() {                  // number of the threads of the current team
+    #ifdef _OPENMP
+        return omp_get_num_threads();
+    #else
+        return 1;
+    #endif
+}
+
+inline bool inParallel() {                  // shows if the caller is in an active parallel region.
+    #ifdef _OPENMP
+        return omp_in_parallel();
+    #else
+        return false;
+    #endif
+}
+
+template <typename T>
+class PlaceReplica {
+  public:
+    ~PlaceReplica() { free(); }
+
+    // allocates the replicas of n items; it must be called outside the parallel regions.
+    void init(int n) {
+        free();
+        this->n = n;
+
+        // the place of each thread
+        std::vector<int> place(1, 0);
+        #pragma omp parallel
+        {
+            #pragma omp single
+            place.assign(threadCount(), 0);
+            place[threadNum()] = placeNum();
+        }
+
+        // the number of the threads of each place and the rank of each thread in its place
+        int nPlaces = 0;
+        for (size_t t = 0; t < place.size(); t++)
+            nPlaces = std::max(nPlaces, place[t] + 1);
+        count.assign(nPlaces, 0);
+        rank.assign(place.size(), 0);
+        for (size_t t = 0; t < place.size(); t++)
+            rank[t] = count[place[t]]++;
+        this->place = place;
+
+        // first touch by the threads of each place
+        replica.assign(nPlaces, NULL);
+        for (int p = 0; p < nPlaces; p++)
+            replica[p] = new T[n];
+        #pragma omp parallel
+        {
+            T* r = local();
+            int begin, end;
+            slab(begin, end);
+            memset(static_cast<void*>(r + begin), 0, (end - begin) * sizeof(T));
+        }
+    }
+
+    int places() const { return int(replica.size()); }
+    T* local() const { return replica[place[threadNum()]]; } // replica of the place of the calling thread
+
+    // copies the slab of the calling thread into its replica; a barrier is needed before reading it.
+    void refresh(const T* src) const {
+        int begin, end;
+        slab(begin, end);
+        memcpy(static_cast<void*>(local() + begin), src + begin, (end - begin) * sizeof(T));
+    }
+  private:
+    int n;
+    std::vector<T*> replica;                // replica[place]
+    std::vector<int> place, rank, count;    // place and rank of each thread and number of threads of each place
+
+    void slab(int& begin, int& end) const { // slab of the calling thread in the replica of its place
+        const int t = threadNum(), c = count[place[t]];
+        begin = int(long(n) * rank[t] / c);
+        end   = int(long(n) * (rank[t] + 1) / c);
+    }
+    void free() {
+        for (size_t p = 0; p < replica.size(); p++)
+            delete[] replica[p];
+        replica.clear();
+    }
+};
+
+#endif
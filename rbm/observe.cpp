@@ -0,0 +1,130 @@
+/***  Observable pipeline, Ver 0.1, Date: 19 Oct 2026 **************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <algorithm>
+#include "numa.h"
+#include "observe.h"
+
+using namespace std;
+
+int ObservablePipeline::add(const string& name, const vector<string>& columns, int width, long interval,
+                            SiteKernel site, Finish finish) {
+    Observable o;
+    o.name     = name;
+    o.columns  = columns;
+    o.width    = width;
+    o.interval = max(1L, interval);
+    o.site     = site;
+    o.finish   = finish;
+    o.column   = list.empty() ? 0 : list.back().column + list.back().columns.size();
+    o.value.assign(columns.size(), 0);
+    o.count    = 0;
+    list.push_back(o);
+    return list.size() - 1;
+}
+
+bool ObservablePipeline::openText(const string& file) {
+    text.open(file.c_str(), ios_base::out | ios_base::trunc);
+    text.precision(10);
+    text << "step, t, lambda, observable, column, value\n";
+    return bool(text);
+}
+
+bool ObservablePipeline::openBinary(const string& file) {
+    binary.open(file.c_str(), ios_base::out | ios_base::trunc | ios_base::binary);
+    writeHeader();
+    return bool(binary);
+}
+
+void ObservablePipeline::close() { // closes the text and binary sinks.
+    if (text.is_open())
+        text.close();
+    if (binary.is_open())
+        binary.close();
+}
+
+void ObservablePipeline::writeHeader() { // writes the header of the binary sink.
+    binary.write("RBMOBS01", 8);
+    int32_t columns = 0;
+    for (size_t k = 0; k < list.size(); k++)
+        columns += list[k].columns.size();
+    binary.write(reinterpret_cast<const char*>(&columns), sizeof(columns));
+    for (size_t k = 0; k < list.size(); k++)
+        for (size_t c = 0; c < list[k].columns.size(); c++) {
+            const string s = list[k].name + "." + list[k].columns[c];
+            binary.write(s.c_str(), s.size() + 1);
+        }
+}
+
+void ObservablePipeline::measure(long step, double t, double lambda, int n) {
+
+    // the due observables and the offsets of their sums
+    vector<int> due, offset;
+    int width = 0;
+    for (size_t k = 0; k < list.size(); k++)
+        if (step % list[k].interval == 0) {
+            due.push_back(k);
+            offset.push_back(width);
+            width += list[k].width;
+        }
+    if (due.empty())
+        return;
+
+    // The team of the caller shares the pass; so the threads of a fused loop do not wait for one of them.
+    if (inParallel())
+        measureTeam(due, offset, width, step, t, lambda, n);
+    else {
+        #pragma omp parallel
+        measureTeam(due, offset, width, step, t, lambda, n);
+    }
+}
+
+void ObservablePipeline::measureTeam(const vector<int>& due, const vector<int>& offset, int width, long step,
+                                     double t, double lambda, int n) {
+
+    // one pass over the sites; each thread adds to its own sums, and then they are added in a fixed order.
+    #pragma omp single
+    part.assign(threadCount() * width, 0);
+    double* a = &part[threadNum() * width];
+    #pragma omp for schedule(static)
+    for (int i = 0; i < n; i++)
+        for (size_t d = 0; d < due.size(); d++)
+            list[due[d]].site(i, a + offset[d]);
+
+    // the values and the sinks; the barrier of single keeps the state of the caller until they are done.
+    #pragma omp single
+    {
+        vector<double> acc(width, 0);
+        for (size_t p = 0; p < part.size(); p++)
+            acc[p % width] += part[p];
+
+        for (size_t d = 0; d < due.size(); d++) {
+            Observable& o = list[due[d]];
+            o.finish(&acc[offset[d]], n, &o.value[0]);
+            o.count++;
+
+            if (text.is_open())
+                for (size_t c = 0; c < o.columns.size(); c++)
+                    text << step << ", " << t << ", " << lambda << ", " << o.name << ", " << o.columns[c] << ", "
+                         << o.value[c] << '\n';
+            if (binary.is_open()) {
+                const int64_t s = step;
+                const int32_t column = o.column;
+                binary.write(reinterpret_cast<const char*>(&s), sizeof(s));
+                binary.write(reinterpret_cast<const char*>(&t), sizeof(t));
+                binary.write(reinterpret_cast<const char*>(&lambda), sizeof(lambda));
+                binary.write(reinterpret_cast<const char*>(&column), sizeof(column));
+                binary.write(reinterpret_cast<const char*>(&o.value[0]), o.value.size() * sizeof(double));
+            }
+            for (size_t s = 0; s < sinks.size(); s++)
+                sinks[s](step, t, due[d], &o.value[0]);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/***  Observable pipeline, Ver 0.1, Date: 19 Oct 2026 **************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * ObservablePipeline measures the registered observables of the lattice, each with its own sampling interval
+ * [steps]. An observable is a reduction kernel:
+ *   site(i, acc)          adds the terms of the site i to its sums acc[0 ... width-1],
+ *   finish(acc, n, out)   gives its values out[0 ... columns-1] from the sums of the n sites.
+ * All observables which are due in a step are evaluated in one parallel pass over the sites, where each thread
+ * adds to its own sums; so the cost of a step is proportional to the width of the due observables, and nothing
+ * is done in the other steps. In a parallel region, measure() must be called by all threads of the team, which
+ * share the pass; otherwise it opens its own parallel region. The values are routed to the sinks:
+ *   text       one line for each value: step, t, lambda, observable, column, value
+ *   binary     the header "RBMOBS01", the number of the columns and their names ("observable.column", each
+ *              ended by '\0'); then one record for each measured observable: step (int64), t, λ (double), index
+ *              of its first column (int32), and its values (double)
+ *   callbacks  e.g. a correlator, which gets the step, t, the index of the observable and its values.
+ * The kernels read the state of the caller, e.g. its global arrays; so the pipeline does not own any state.
+ */
+
+#ifndef OBSERVE_H
+
+#define OBSERVE_H
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class ObservablePipeline {
+  public:
+    typedef void (*SiteKernel)(int i, double* acc);
+    typedef void (*Finish)(const double* acc, int n, double* out);
+    typedef void (*Sink)(long step, double t, int k, const double* value);
+
+    // registers an observable with its columns, the number of its sums and its interval [steps]; it returns the
+    // index of the observable.
+    int add(const std::string& name, const std::vector<std::string>& columns, int width, long interval,
+            SiteKernel site, Finish finish);
+    void addSink(Sink sink) { sinks.push_back(sink); }
+
+    bool openText(const std::string& file);
+    bool openBinary(const std::string& file);
+    void close();                           // closes the text and binary sinks.
+
+    bool due(long step) const {             // shows if any observable is due in the step.
+        for (size_t k = 0; k < list.size(); k++)
+            if (step % list[k].interval == 0)
+                return true;
+        return false;
+    }
+
+    // evaluates the observables which are due in the step, and routes their values to the sinks; in a parallel
+    // region, it is called by all threads of the team and ends with a barrier.
+    void measure(long step, double t, double lambda, int n);
+
+    int size() const { return list.size(); }
+    const std::string& name(int k) const { return list[k].name; }
+    const double* value(int k) const { return &list[k].value[0]; } // the last values of the observable k
+    long measurements(int k) const { return list[k].count; }
+  private:
+    struct Observable {
+        std::string name;
+        std::vector<std::string> columns;
+        int width;
+        long interval;
+        SiteKernel site;
+        Finish finish;
+        int column;                         // index of its first column in the binary sink
+        std::vector<double> value;
+        long count;
+    };
+    std::vector<Observable> list;
+    std::vector<Sink> sinks;
+    std::ofstream text, binary;
+    std::vector<double> part;               // the sums of each thread in measure()
+
+    void writeHeader();                     // writes the header of the binary sink.
+    // the pass of the team over the sites and the values of the due observables
+    void measureTeam(const std::vector<int>& due, const std::vector<int>& offset, int width, long step, double t,
+                     double lambda, int n);
+};
+
+#endif
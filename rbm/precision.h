@@ -0,0 +1,178 @@
+/***  Precision policies, Ver 0.1, Date: 19 Oct 2026 ****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * A precision policy selects the floating-point types of the simulation:
+ *   real   type of the state (μ, Bₜ, the coupling tensors, ...),
+ *   field  type of the per-dipole accumulation Σⱼ J̃ᵢⱼ μⱼ in calcBTotal(),
+ *   accum  type of the global reductions over the lattice (〈μᵢ〉, energy, ...).
+ * If compensated is true, the global reductions use the Kahan summation.
+ *
+ * The coupling table J̃ᵢⱼ can be stored with a narrower type than real. The tensor is symmetric,
+ * so a packed table keeps only its 6 independent components.
+ */
+
+#ifndef PRECISION_H
+
+#define PRECISION_H
+
+#include <stdint.h>
+#include <string.h>
+#include <eigen3/Eigen/Dense>
+
+//------------------------------------------------------------------------------
+// Precision policies
+template <int P> struct Precision;
+
+template <> struct Precision<0> {           // all-float with the compensated reductions
+    typedef float real;
+    typedef float field;
+    typedef float accum;
+    static const bool compensated = true;
+    static const char* name() { return "float, compensated reductions"; }
+};
+
+template <> struct Precision<1> {           // float state with the double accumulators
+    typedef float real;
+    typedef float field;
+    typedef double accum;
+    static const bool compensated = false;
+    static const char* name() { return "float, double accumulators"; }
+};
+
+template <> struct Precision<2> {           // all-double
+    typedef double real;
+    typedef double field;
+    typedef double accum;
+    static const bool compensated = false;
+    static const char* name() { return "double"; }
+};
+// Precision policies
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Summation
+/* Sum<T, compensated> accumulates the values of type T (a scalar or an Eigen vector). If compensated is
+ * true, the Kahan summation is used; it keeps the rounding error of a float sum independent of the number
+ * of terms. Example:
+ *   Sum<Vector3f, true> S;
+ *   for (int i = 0; i < N; i++) S += mu[i];
+ *   Vector3f M = S.value() / N; */
+template <typename T, bool compensated> struct Sum;
+
+inline void setZero(float& x)  { x = 0; }
+inline void setZero(double& x) { x = 0; }
+template <typename Derived>
+inline void setZero(Eigen::MatrixBase<Derived>& x) { x.setZero(); }
+
+template <typename T> struct Sum<T, false> {
+    T s;
+    Sum() { setZero(s); }
+    Sum& operator+=(const T& x) { s += x; return *this; }
+    const T& value() const { return s; }
+};
+
+template <typename T> struct Sum<T, true> {
+    T s, c;                                 // sum and the running compensation
+    Sum() { setZero(s); setZero(c); }
+    Sum& operator+=(const T& x) {
+        T y = x - c;
+        T u = s + y;
+        c = (u - s) - y;
+        s = u;
+        return *this;
+    }
+    const T& value() const { return s; }
+};
+// Note: -Ofast implies -ffast-math which may cancel the Kahan compensation. So the code must be compiled
+// with -fno-associative-math if PRECISION == 0; see "make release_kahan".
+// Summation
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Storage of the coupling table
+// COUPLING_STORAGE == 0: real (full Eigen 3x3 matrix)
+// COUPLING_STORAGE == 1: bfloat16 (packed; 8-bit mantissa)
+// COUPLING_STORAGE == 2: float16 (packed; 11-bit mantissa, needs _Float16 support of the compiler)
+
+struct bfloat16 {                           // the upper 16 bits of an IEEE-754 float
+    uint16_t bits;
+    bfloat16() : bits(0) {}
+    bfloat16(float x) {
+        uint32_t u;
+        memcpy(&u, &x, 4);
+        u += 0x7FFF + ((u >> 16) & 1);      // round to the nearest even
+        bits = uint16_t(u >> 16);
+    }
+    operator float() const {
+        uint32_t u = uint32_t(bits) << 16;
+        float x;
+        memcpy(&x, &u, 4);
+        return x;
+    }
+};
+
+/* PackedCoupling<S> stores a symmetric 3x3 coupling tensor by its 6 independent components in the storage
+ * type S: (xx, yy, zz, xy, xz, yz). The product with a vector is evaluated in the type of the vector. */
+template <typename S> struct PackedCoupling {
+    S c[6];
+    PackedCoupling() {}
+    template <typename Derived>
+    PackedCoupling(const Eigen::MatrixBase<Derived>& J) { *this = J; }
+    template <typename Derived>
+    PackedCoupling& operator=(const Eigen::MatrixBase<Derived>& J) {
+        c[0] = float(J(0,0)); c[1] = float(J(1,1)); c[2] = float(J(2,2));
+        c[3] = float(J(0,1)); c[4] = float(J(0,2)); c[5] = float(J(1,2));
+        return *this;
+    }
+    template <typename Real>
+    Eigen::Matrix<Real,3,1> operator*(const Eigen::Matrix<Real,3,1>& v) const {
+        const Real xx = Real(float(c[0])), yy = Real(float(c[1])), zz = Real(float(c[2])),
+                   xy = Real(float(c[3])), xz = Real(float(c[4])), yz = Real(float(c[5]));
+        return Eigen::Matrix<Real,3,1>(xx * v.x() + xy * v.y() + xz * v.z(),
+                                       xy * v.x() + yy * v.y() + yz * v.z(),
+                                       xz * v.x() + yz * v.y() + zz * v.z());
+    }
+    template <typename Real>
+    Eigen::Matrix<Real,3,3> matrix() const {
+        Eigen::Matrix<Real,3,3> J;
+        J << Real(float(c[0])), Real(float(c[3])), Real(float(c[4])),
+             Real(float(c[3])), Real(float(c[1])), Real(float(c[5])),
+             Real(float(c[4])), Real(float(c[5])), Real(float(c[2]));
+        return J;
+    }
+};
+
+template <int S, typename Real> struct CouplingStorage;
+
+template <typename Real> struct CouplingStorage<0, Real> {
+    typedef Eigen::Matrix<Real,3,3> type;
+    static const char* name() { return "real"; }
+};
+
+template <typename Real> struct CouplingStorage<1, Real> {
+    typedef PackedCoupling<bfloat16> type;
+    static const char* name() { return "bfloat16"; }
+};
+
+#ifdef __FLT16_MAX__
+template <typename Real> struct CouplingStorage<2, Real> {
+    typedef PackedCoupling<_Float16> type;
+    static const char* name() { return "float16"; }
+};
+#endif
+
+// converts a stored coupling tensor back to a matrix of type Real, e.g. couplingMatrix<double>(Jtilda[i][j])
+template <typename Real, typename Derived>
+inline Eigen::Matrix<Real,3,3> couplingMatrix(const Eigen::MatrixBase<Derived>& J) { return J.template cast<Real>(); }
+template <typename Real, typename S>
+inline Eigen::Matrix<Real,3,3> couplingMatrix(const PackedCoupling<S>& J) { return J.template matrix<Real>(); }
+// Storage of the coupling table
+//------------------------------------------------------------------------------
+
+#endif
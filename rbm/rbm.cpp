@@ -1,675 +1,2441 @@
-/***  Rotational Brownian Motion, Ver 1.2, Date: 17 May 2022 ******************
- ***                                                                        ***
- ***  Copyleft (ɔ) Nasim 2020-22, All lefts reserved!                       ***
- ***                                                                        ***
- ******************************************************************************
- 
- * This code is under construction. It might contain some errors.
- * So you can try it at your own risk!
- */
-
-//#define DEBUG_MODE                          // Activate debug mode
-//#define NO_WAIT                             // Deactivate wait() at the end of code; see utils.h
-
-#include <cstdlib>
-#include <stdio.h>
-#include <iostream>
-#include <fstream>
-#include <math.h>
-#include <string>
-#include <omp.h>
-#include <eigen3/Eigen/Dense>
-#include <eigen3/Eigen/Geometry>
-#include "mtutils.h"
-#include "random.h"
-#include "utils.h"
-#include "estJ.h"
-#include "Binder.h"
-
-using namespace std;
-using namespace Eigen;
-
-// Constants //
-// ========= //
-const int NR = 500;                         // Number of realizations (ensembles)
-const int L = 30;                           // L x L unit cell lattice
-const int N = sqr(L);                       // Number of dipoles in the unit cell (supercluster) 
-const int ceq = 400;                        // Number of steps that are needed for approaching the equilibrium state
-const double muNP = 1.4e-15;                // The magnetic moment of one nanoparticle [J/T or A.m²/kg]
-const double muSC = NSC * muNP;             // The magnetic moment of supercluster [J/T or A.m²/kg]
-const double kB = 1.38e-23;                 // Boltzmann constant [J/K]
-
-const float T = 310;                        // The human body temperature [K]
-const float mu0 = 4 * pi * 1e-7;            // The magnetic permeability of vacuum [N/A²]
-const float dt = 1. / 256;                  // Δt [τ_D]
-const float l = 1.e-4;                      // Average distance between adjacent superclusters in meninges
-const float l3 = pow(l, 3);                 // l³
-const float aNP = 8.5e-8;                   // The average radius of nanoparticles = 85 * 10⁻⁹ [m]
-const float eta = 0.69e-3;                  // Viscosity of cytoplasm [Pa.s]; 0.69 [mPa.s] for water in 37 ֯C
-const float tmax = 1.e6;                     // Maximum of simulation time [τ_D]
-const float zeta = NSC * 8 * pi *           // Random noise torque coefficient
-                   pow(aNP, 3) * eta;
-// λ is a unitless constant that compares magnetic energy with thermal fluctuation. The critical value of λ
-const float lambdaC = 1/(0.33+0.61/log10(N));
-const float lambdaMax = 12;                 // The maximum of λ
-const float tauD = zeta / (2 * kB * T);     // Debye relaxation time, ζ/(2k_B T) [s]
-const float m_lambda = 0.014                      // the slogan of variable lambda
-
-const Vector3f BDC0(0, 0, 0);               // DC part of external magnetic field [B⁎]; in the initial part,
-const Vector3f BDC1(1, 0, 0);               // and in the 2ⁿᵈ part of dynamics. note: 65 [µT] ~ 2100 [B⁎].
-const Vector3f a(1, 0, 0),                  // Bases of the triangular Bravais lattice
-               b(0.5, 0.5 * sqrt(3), 0);    // Maximum of simulation time [τ_D]
-
-
-#define DATA 0
-// If DATA == 1, the snapshots are recorded.
-
-#define DYNAMICS 0
-// If DYNAMICS == 0, the dynamics are simple without any change in external condition.
-// If DYNAMICS == 1, the dynamics are continuing after lambdaMax up to tMax.
-
-const static IOFormat CSVFormat(StreamPrecision, DontAlignCols, ", ", "\n");
-
-// Variables
-// =========
-float t;                                    // Current time in the simulation [τ_D]
-float lambda;                               // λ is a unitless constant which compares magnetic energy with
-                                            // thermal fluctuation
-float theta;                                // Angle of rotating magnetic field
-
-Vector3f* r;                                // Position of dipoles [l]
-Vector3f* mu;                               // Direction of magnetic moment of dipoles, where |μ[i]| == 1
-BinderCumulant BC;                          // calculate the Binder's cumulant. It is gets samples and
-                                            // calculated in execute()!
-Matrix3f Jinf;                              // J(∞) = \lim_{R→∞} J(R)
-Matrix3f** Jtilda;                          // Jtilda[i][j] shows the total coupling of the iᵗʰ
-                                            // dipole with all jᵗʰ dipoles in any cells.
-Matrix3f* dJ;                               // \delta J[i] shows the reminder of interaction between
-                                            // the iᵗʰ dipole and the entire lattice out of the constant
-                                            // radius R in init().
-Vector3f* BT;                               // Bₜ[i] shows the total magnetic field at rᵢ [B⁎]
-
-Vector3f BDC;                              // DC part of external magnetic field [B⁎].
-
-// File stream
-// ============
-ofstream snapshot;                          // The position and magnetic moment of all particles are stored in
-                                            // the snapshot stream with the dict. format.
-ofstream res;                               // The result of simulation
-
-// ===== //
-void init();                                // Common initialization
-void done();                                // Common finalization
-
-void init(int rI);                          // Initializing the rIᵗʰ realization
-void done(int rI);                          // Finalization of rIᵗʰ realization
-
-Vector3f mu_avg();                          // Average of 〈μᵢ〉
-void calcBTotal();                          // calculates the total magnetic field by using the coupling tensor in
-                                            // the unit cell and mean field for the remainder of the lattice. Then
-                                            // it updates Bₜ[].
-float magEnergy();                          // calculates the total magnetic energy.
-void execute();                             // approaching to equilibrium
-
-// simulates the system and changes λ from 0 to λₘₐₓ
-void execute(float lambda1);
-
-// simulates the system and increases λ from 0 to λₘₐₓ, where rI is a realization index.
-void execute(int rI);
-
-// Simulates a single hysteresis loop, where λ₀ = 3λc, ΔB shows the linear changes
-// in the external magnetic field in each step of simulation, B₀ shows the maximum
-// amplitude of external magnetic field, and rI is a realization index.
-void executeHysteresis(int rI, const Vector3f dB, const float B0 = 1, const float lambda0 = 3*lambdaC);
-
-// simulates a rotational external magnetic field, where B₀ shows
-// the amplitude of the magnetic field and rI is a realization index.
-void executeRotationalB(int rI, const float B0 = 1);
-
-void executeSingleStep();                   // executes a single time step.
-void exportHeader();                        // exports the header to the snapshot stream
-                                            // means exclude header.
-void exportResult(int id);                  // exports the current state to the res stream. θ shows the angle
-                                            // of external magnetic field.
-void exportSnapshot(int id);                // exports the current state to the snapshot stream,
-                                            // where id is the index of data block.
-
-// functions definition //
-// ==================== //
-int main (int argc, char *argv[]) { // Main routine
-
-    lout << "\nRotaional Brownian Motion, Ver 1.22\n"
-         << "Copyleft (ɔ) Nasim 2020-22, All lefts reserved!\n"
-         << "Date: 14010302" << endl;
-
-    init_mtutils(10);                        // initiates the OpenMP
-    // Note: Due to the simultaneous use of the SSE instruction set and OpenMP, and the competition between
-    // the SSE instructions set and the separate cores in using the floating-point units and cache, defining
-    // the maximum allowed value for the number of CPU cores in OpenMP may not be the best choice due to some
-    // overloads. The appropriate amount depends on the number of actual floating units available and the size of
-    // cache. For cheap processors, half of the number of CPU cores might be enough!
-
-    // Randomize the pseudo-random number generator
-    randomize();
-    lout << "\nseed: " << seed << endl;
-
-    // manage the input switches
-    if ((argc == 2) && (string(argv[1]) == "-Jinf"))
-        Store_Jinf(a, b);
-
-    if (!IsFileExist("J_inf.csv"))
-        Store_Jinf(a, b);
-
-    // loads the estimation of J₁₁(∞) which is estimated by the subroutine Store_Jinf().
-    ifstream J_inf("J_inf.csv", std::ios_base::in);
-
-    // Reads the J₁₁(∞) from J_inf.txt
-    float J;
-    J_inf >> J;
-
-    // and initializes the Jinf.
-    Jinf << J, 0, 0,
-            0, J, 0,
-            0, 0, -2 * J;
-
-    // Introducing the parameters before beginning
-    lout << "unit cell: " << L << " x " << L << "\tNᵣ: " << NR
-         << "\nT: "  << T << " [K]\t\tDC part of Bₑₓₜ: (" << BDC.transpose().format(CSVFormat) << ") [B⁎]"
-         << "\na: (" << a.transpose().format(CSVFormat) << ")\t\tb: (" << b.transpose().format(CSVFormat) << ')'
-         << setprecision(3)
-         << "\nτD: " << tauD << " [s]\t\tμSC: " << muSC << " [J/T or A.m²/kg]"
-         << "\nl: "  << l << "\t\tλc: " << lambdaC
-         << "\nb0 (intercept colding lambda): " << 1/(1.2 * N + 465.8)
-         << "\nm (slope for colding lambda): " << m_lambda  << endl;
-
-    // calculates the executing time of the main section of code.
-    lout.start();
-
-    // initialization
-    init();
-
-    for (int r = 1; r <= NR; r++) { // A realization loop
-
-        init(r);
-
-        // The following line could be used in the remote SSH running!!!
-        lout.echo(false);
-
-        // Uncomment one of the following lines according to the simulation plan: //
-        execute(r);
-        //executeHysteresis(r, Vector3f(0.01, 0, 0), 1);
-        //executeRotationalB(r, 1);
-
-        // The following line could be used in the remote SSH running!!!
-        lout.echo(true);
-
-        done(r);
-
- 	    lout << "Execution of the " + to_string(r) + "ᵗʰ realization is Finished!" << endl;
-    }
-
-    done();
-
-    // calculates the executing time of the main section of code.
-    lout.stop();
-
-    lout << "Finish!" << endl;
-
-    wait();
-
-    free_mtutils();
-
-    return 0;
-}
-
-void init() { // Common initialization of all realizations
-
-    r  = new Vector3f[N];
-    mu = new Vector3f[N];
-    BT = new Vector3f[N];
-    dJ = new Matrix3f[N];
-
-    // Initializing the lattice points
-    int k = 0;
-    for (int i = 0; i < L; i++)
-        for (int j = 0; j < L; j++)
-            r[k++] = i * a + j * b;
-
-    if ( L <= 3) { // Following lines show points of a small lattice
-        int k = 0;
-        for (int i = 0; i < L; i++)
-            for (int j = 0; j < L; j++) {
-                lout << "i: " << i << '\t'
-                     << "j: " << j << '\t'
-                     << "ia + jb = [" << r[k++].transpose().format(CSVFormat) << ']' << endl;
-            }
-    }
-    // Jtilta is calculated for a triangular lattice of radius R
-    const int R = 500;
-    const float RMax = R * sin(pi/3);
-
-    // Allocating the temporary memory for double precision dJtilda
-    Matrix3d** dJtilda  = new Matrix3d*[N];
-    for (int i=0; i < N; i++) {
-        dJtilda[i] = new Matrix3d[N];
-        for (int j=0; j < N; j++)
-            dJtilda[i][j] = Matrix3d::Zero();
-    }
-
-    // Computing the couplings with double precision in dJtilda[][]
-    for (int i = 0; i < N; i++)
-        for (int j = 0; j < N; j++)
-            for (int k = -R/L; k <= R/L; k++)
-                for (int l = -R/L; l <= R/L; l++) {
-                    Vector3f d = r[j] - r[i] + L*k*a + L*l*b;
-
-                    // Increase the symmetry of calculation
-                    if ( d.squaredNorm() <= RMax )
-                        dJtilda[i][j] += couplingJ( d ).cast<double>();
-                }
-
-    // Assign dJtilda[][] to Jtilda[][]
-    Jtilda  = new Matrix3f*[N];
-    for (int i = 0; i < N; i++) {
-        Jtilda[i] = new Matrix3f[N];
-        for (int j = 0; j < N; j++)
-            Jtilda[i][j] = dJtilda[i][j].cast<float>();
-    }
-
-    // Calculating the difference of Jtilda and J(∞) and assign it to dJ[]
-    for (int i = 0; i < N; i++) {
-        Matrix3d JTotal = Matrix3d::Zero();
-        for (int j = 0; j < N; j++)
-            JTotal += dJtilda[i][j];
-        dJ[i] = Jinf - JTotal.cast<float>();
-    }
-
-    // Deallocating the temporary memory of dJtilda
-    for (int i = 0; i < N; i++)
-        delete[] dJtilda[i];
-    delete[] dJtilda;
-}
-
-void done() { // Common finalization
-
-    delete[] r;
-    delete[] mu;
-    delete[] BT;
-    delete[] dJ;
-
-    for (int i = 0; i < N; i++)
-        delete[] Jtilda[i];
-    delete[] Jtilda;
-}
-
-void init(int rI) { // Initializing the rIᵗʰ realization
-
-    t = 0;
-    lambda = 0.1;
-    // First value of changing angle
-    theta = 0;
-    // DC magnetic field in the 1ˢᵗ part of dynamics.
-    BDC = BDC0;
-
-    // Initializing {μᵢ} with random direction
-    for (int i = 0; i < N; i++) {
-        mu[i] = rndDir();
-    }
-    // Initial value of Binder cumulant.
-    BC.init();
-
-    #if DATA == 1
-        snapshot.open("snapshot" + to_string(rI) + ".txt", std::ios_base::out | std::ios_base::trunc);
-        exportHeader();
-    #endif
-
-    res.open("result" + to_string(rI) + ".txt", std::ios_base::out | std::ios_base::trunc);
-    res << setprecision(3) << "{" << "\"result\": {" << endl;
-}
-
-void done(int rI) { // Finalization of rIᵗʰ realization
-
-    #if DATA == 1
-        snapshot.close();
-    #endif
-
-    res.close();
-}
-
-Vector3f mu_avg() { // Average of 〈μᵢ〉
-
-    Vector3f S = Vector3f::Zero();
-    for (int i = 0; i < N; i++)
-        S += mu[i];
-
-    return S / N;
-}
-
-void calcBTotal() { // calculates the total magnetic field by using the coupling tensor in the unit cell
-                    // and mean field for the remainder of the lattice. Then it updates Bₜ[].
-
-    const Vector3f mu_MF = mu_avg();
-
-    #pragma omp parallel for
-    for (int i = 0; i < N; i++) {
-        // Total net magnetic field produced by dipoles at rᵢ
-        Vector3f BDs = Vector3f::Zero();
-
-        for (int j = 0; j < N; j++) {
-            BDs += Jtilda[i][j] * mu[j];
-        }
-        BT[i] = BDC + lambda * (BDs + dJ[i] * mu_MF);
-    }
-}
-
-float magEnergy() { // calculates the total magnetic energy.
-
-    double S = 0;
-    //#pragma omp parallel for reduction (+: S) WHY?
-
-    for(int i = 0; i < N; i++)
-        // S -= mu[i].dot(BDC) + 0.5 * mu[i].dot(BT[i] - BDC);
-        // Current line multiple 0.5 is derived from the previous equation.
-        S -= mu[i].dot(BDC + BT[i]);
-
-    S *= 0.5;
-
-    return S / (N * lambda);
-}
-
-void executeSingleStep() { // executes a single time step.
-
-    calcBTotal();
-
-    #pragma omp parallel for
-    for (int i = 0; i < N; i++) { // The following loop evaluates μ^{(n+1)} White Gaussian 3d noise
-
-        Vector3f W(rndN(), rndN(), rndN());
-        mu[i] +=  0.5 * dt * ( BT[i] - mu[i].dot(BT[i]) * mu[i] ) + // Note: |μ[i]| == 1
-                  sqrt(dt) * W.cross(mu[i]);
-
-// Normalize mu
-        mu[i].normalize();
-    }
-    t += dt;
-}
-
-void execute() { // approaching to equilibrium
-    for (int c = 0; c < ceq; c++)
-        executeSingleStep();
-}
-
-void execute(float lambda1) { // simulates the system and changes λ from 0 to λ₁.
-
-    while (lambda < lambda1) {
-        execute();
-
-            //lambda += b0 + m * |lambda - lambdaC|;
-
-            //lambda += 1/(489.16 + 1.3 N) +
-            //          1/(40.35 + 0.73 L) * fabs(lambda - lambdaC);
-
-           lambda += 1/(1.2 * N + 465.8)
-                     m_lambda * fabs(lambda - lambdaC);
-
-        lout << prog << "t = " << fixed << setprecision(2) << t << "\tλ = " << lambda;
-    }
-    // for being sure in the end that lambda is equal to λ₁.
-    lambda = lambda1;
-    execute();
-}
-
-void execute(int rI) { // simulates the system and increase λ from 0 to λₘₐₓ,
-                       // where rI is a realization index.
-    #if DATA == 1
-        exportSnapshot(1);
-        int cSnapshot = 2;
-    #endif
-
-    int c = 1;
-    int cRes = 1;
-    exportResult(cRes++);
-
-    while (lambda < lambdaMax) { // changes λ from 0 to λₘₐₓ
-
-        executeSingleStep();
-        // 〈μᵢ〉
-        Vector3f M1 = mu_avg();
-        BC.sample(M1.squaredNorm());
-
-        if (c % ceq == 0) { // wait for equilibrium; ceq Δt ~ relaxation time?
-
-            res << "," << endl;
-            exportResult(cRes++);
-
-            //lambda += b0 + m * |lambda - lambdaC|;
-            //lambda += 1/(489.16 + 1.3 N) +
-            //          1/(40.35 + 0.73 L) * fabs(lambda - lambdaC);
-
-            lambda += 1/(1.2 * N + 465.8)
-                     m_lambda * fabs(lambda - lambdaC);
-
-        }
-        #if DATA == 1
-            if (c % 40 == 0) {
-                snapshot << "," << endl;
-                exportSnapshot(cSnapshot++);
-            }
-        #endif
-        c++;
-        lout << prog << fixed << setprecision(2)
-             << "t = "       << t
-             << "\tλ = "     << lambda
-             << "\t〈μᵢ〉 = (" << M1.transpose().format(CSVFormat) << ")       ";
-    }
-
-    #if DYNAMICS == 1
-
-        lambda = lambdaMax;
-
-        for (int i = 0; i < ceq; i++) { // last step of λ to λ_max
-        executeSingleStep();
-
-        #if DATA == 1
-            if (c % 40 == 0) {
-                snapshot << "," << endl;
-                exportSnapshot(cSnapshot++);
-            }
-        #endif
-
-        c++;
-
-        lout << prog << fixed << setprecision(2) << "t\t"<< t;
-        }
-
-        lout << "\n\nThe system reaches to the critical point.\n"
-            << "Now, the external field is turned on!" << endl;
-
-        // The DC magnetic field in 2ⁿᵈ part of dynamics.
-        BDC = BDC1;
-
-        lout << fixed << setprecision(4)
-            << "t = " << t << "\tB_DC = ("
-            << resetiosflags(std::ios_base::floatfield | std::ios_base::showpoint)
-            << setprecision(-1)                // resets the stream format
-            << BDC.transpose().format(CSVFormat) << ")\n" << endl;
-
-        BC.init();
-
-        while (t < tmax) { // dynamics of the system at λ_max
-            executeSingleStep();
-
-            // 〈μᵢ〉
-            Vector3f M1 = mu_avg();
-            BC.sample(M1.squaredNorm());
-
-            // wait for equilibrium; ceq Δt ~ relaxation time?
-            if (c % ceq == 0){
-                res << "," << endl;
-                exportResult(cRes++);
-
-            #if DATA >= 2
-            if ((c % 40 == 0) && (lambda > 0) && (rI == 1)) {
-                snapshot << "," << endl;
-                exportSnapshot(cSnapshot++);
-            }
-            #endif
-            }
-
-            c++;
-
-            lout << prog << fixed << setprecision(2)
-                << "t = "       << t
-                << "\tλ = "     << lambda
-                << "\t〈μᵢ〉 = (" << M1.transpose().format(CSVFormat) << ")       ";
-        }
-
-    #endif  // DYNAMICS == 1
-
-    #if DATA == 1
-        snapshot << "}}" << endl;
-    #endif
-
-    res << "}}" << endl;
-    lout << '\n' << endl;
-}
-
-void executeHysteresis(int rI,
-                       const Vector3f dB,     // linear changes in the external magnetic field in each step of
-                       const float B0,        // simulation, B₀ shows the amplitude of magnetic field, and rI
-                       const float lambda0) { // is a realization index.
-
-    // Hysteresis loop has 3 sections, 0: B = [0, B₀], 1: B = [B₀, -B₀], 2: B = [-B₀, B₀].
-    int loop_counter = 0;
-    // to change direction of changing external B
-    int sign = +1;
-    // fixed lambda, first point
-    lambda = lambda0;
-    // counter to saving results.
-    int cRes = 1;
-    exportResult(cRes++);
-
-    while (loop_counter < 3) {
-
-        execute();
-
-        res << "," << endl;
-        exportResult(cRes++);
-
-        BDC += sign * dB;
-
-        if ( BDC.norm() > B0 ) { // to prevent BDC to exceed the max/min value
-            loop_counter++;
-            sign *= -1;
-        }
-        lout << prog << fixed << setprecision(2)
-             << "time = " << t
-             << "\tB = (" << BDC.transpose().format(CSVFormat) << ')';
-    }
-    res << "}}" << endl;
-
-    lout << endl;
-}
-
-void executeRotationalB(int rI, const float B0) { // simulates a rotational external magnetic field, where B₀ shows
-                                                  // the amplitude of magnetic field and rI is a realization index.
-    // ΔB
-    const float dB = 0.01;
-    // Δθ
-    const float deltaTheta = 0.01 * pi;
-
-    // At first system must be at the critical point.
-    execute(lambdaC);
-
-    while (BDC.x() <= B0) {
-
-        execute();
-        BDC.x() += dB;
-
-        lout << prog << fixed << setprecision(2)
-             << "t = " << t
-             << "\tB = (" << BDC.transpose().format(CSVFormat) << ')';
-    }
-    int cRes = 1;
-    float theta = 0;
-
-    // Simulating the rotating magnetic field, and simultaneously export the results.
-    while (theta <= 2 * pi ) {
-        BDC = Vector3f(cos(theta), sin(theta), 0);
-
-        execute();
-
-        if (cRes > 1)
-            res << "," << endl;
-        exportResult(cRes++);
-
-
-        theta += deltaTheta;
-
-        lout << prog << fixed << setprecision(2)
-             << "t = " << t
-             << "\tB = (" << BDC.transpose().format(CSVFormat) << ')';
-    }
-    res << "}}" << endl;
-
-    lout << endl;
-}
-
-void exportHeader() { // exports the header to the snapshot stream
-
-    snapshot << fixed << setprecision(3);
-
-    // Header of the snapshot file
-    snapshot << "{\n"
-             << "\"lattice\": {\n"
-             << "\"items\": " << N << ",\n"
-             << "\"lacations\": [" << endl;
-
-    for (int i = 0; i < N; i++) {
-        snapshot << "\"(" << r[i].transpose().format(CSVFormat) << ")\"";
-
-        if (i != N - 1)
-            snapshot << ",\n";
-    }
-    snapshot << "]}\n,\n"
-             << "\"snapshot\": {" << endl;
-}
-
-void exportResult(int id) { // exports the current state to the res stream.
-
-    Vector3f mu = mu_avg();
-
-    res << "\"" << id << "\": {\n"
-        << "\"items\": " << N << ",\n"
-        << "\"lambda\":" << lambda << ",\n"
-        << "\"time\":"   << t << ",\n"
-        << "\"theta\":"  << theta << ",\n"
-        << "\"Total Magnetic Energy\":" << magEnergy() << ",\n"
-        << "\"Magnetization\": "  << mu.norm() << ",\n"
-        << "\"Binder Cumulant\": " << BC.BC(true) << ",\n"
-        << "\"B.x\": " << BDC.x() << ",\n"
-        << "\"B.y\": " << BDC.y() << ",\n"
-        << "\"B.z\": " << BDC.z() << ",\n"
-        << "\"Mp\": " << sqrt(sqr(mu.x()) + sqr(mu.y())) << ",\n"
-        << "\"Mx\": " << mu.x() << ",\n"
-        << "\"My\": " << mu.y() << ",\n"
-        << "\"Mz\": " << mu.z() << "}" << endl;
-}
-
-void exportSnapshot(int id) { // exports the current state to the snapshot stream
-
-    snapshot << "\"" << id << "\": {\n"
-             << "\"items\": " << N << ",\n"
-             << "\"lambda\":" << lambda << ",\n"
-             << "\"time\":"   << t << ",\n"
-             << "\"Energy\":" << magEnergy() << ",\n"
-             << "\"data\": [\n";
-
-    for (int i = 0; i < N; i++) {
-        snapshot << "\"(" << mu[i].transpose().format(CSVFormat) << ")\"";
-        if (i != N - 1)
-            snapshot << "," << endl;
-    }
-    snapshot << "]}" << endl;
-}
-
+/***  Rotational Brownian Motion, Ver 1.2, Date: 17 May 2022 ******************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-22, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ 
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+//#define DEBUG_MODE                          // Activate debug mode
+//#define NO_WAIT                             // Deactivate wait() at the end of code; see utils.h
+
+#include <cstdlib>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <math.h>
+#include <string>
+#include <sstream>
+#include <ctime>
+#include <omp.h>
+#include <eigen3/Eigen/Dense>
+#include <eigen3/Eigen/Geometry>
+#include "mtutils.h"
+#include "mpiutils.h"
+#include "random.h"
+#include "utils.h"
+#include "estJ.h"
+#include "Binder.h"
+#include "precision.h"
+#include "stat.h"
+#include "histogram.h"
+#include "ensemble.h"
+#include "corr.h"
+#include "lattice.h"
+#include "minimize.h"
+#include "statelib.h"
+#include "fields.h"
+#include "topology.h"
+#include "snapring.h"
+#include "snapcode.h"
+#include "numa.h"
+#include "fieldtrack.h"
+#include "observe.h"
+#include "correlator.h"
+#include "telemetry.h"
+
+using namespace std;
+using namespace Eigen;
+
+#ifndef PRECISION
+#define PRECISION 1
+#endif
+// If PRECISION == 0, all variables are float and the reductions over the lattice are compensated.
+// If PRECISION == 1, the state is float and the reductions over the lattice are accumulated in double.
+// If PRECISION == 2, all variables are double.
+
+#ifndef COUPLING_STORAGE
+#define COUPLING_STORAGE 0
+#endif
+// If COUPLING_STORAGE == 0, Jtilda[][] is stored with the precision of the state.
+// If COUPLING_STORAGE == 1, Jtilda[][] is stored in bfloat16, and if COUPLING_STORAGE == 2, in float16.
+
+#ifndef LATTICE
+#define LATTICE 0
+#endif
+// LATTICE selects the Bravais lattice and the basis of its cell; see lattice.h.
+// If LATTICE == 0, triangular, 1: square, 2: honeycomb, 3: kagome; the nearest neighbors are at the distance l.
+
+typedef Precision<PRECISION> Policy;
+typedef Policy::real Real;                  // type of the state
+typedef Matrix<Real, 3, 1> Vec3;
+typedef Matrix<Real, 3, 3> Mat3;
+typedef Matrix<Policy::field, 3, 1> Vec3F;  // accumulator of Σⱼ J̃ᵢⱼ μⱼ
+typedef Policy::accum accum;                // accumulator of the reductions over the lattice
+typedef Matrix<accum, 3, 1> Vec3A;
+typedef CouplingStorage<COUPLING_STORAGE, Real> Storage;
+typedef Storage::type JStore;               // stored type of J̃ᵢⱼ
+
+// The extra field terms of fields.h, which are added to Bₜ[i] in the same pass as the dipolar field, e.g.
+//   typedef FieldPipeline<UniaxialAnisotropy<Real>, CubicAnisotropy<Real>, Exchange<Real>, SiteField<Real> > Fields;
+typedef FieldPipeline<> Fields;
+
+// Constants //
+// ========= //
+const int NR = 500;                         // Number of realizations (ensembles)
+const int L = 30;                           // L x L unit cell lattice
+const int layers = 1;                       // Number of the stacked layers of the lattice
+const float dLayer = 1;                     // Distance between the layers [l]
+const Lattice lattice = Lattice::byIndex(LATTICE).stack(layers, Vector3f(0, 0, dLayer));
+const int nSites = lattice.sites();         // Number of the sites (sublattices) in each cell of the lattice
+const int N = sqr(L) * nSites;              // Number of dipoles in the unit cell (supercluster) 
+const int ceq = 400;                        // Number of steps that are needed for approaching the equilibrium state
+const float BCErrMax = 0;                   // If BCErrMax > 0, a λ step of execute(int) ends as soon as the error
+                                            // bar of the Binder cumulant reaches BCErrMax, but not before
+const int ceqMin = ceq / 4;                 // ceqMin steps.
+const double muNP = 1.4e-15;                // The magnetic moment of one nanoparticle [J/T or A.m²/kg]
+const double muSC = NSC * muNP;             // The magnetic moment of supercluster [J/T or A.m²/kg]
+const double kB = 1.38e-23;                 // Boltzmann constant [J/K]
+
+const float T = 310;                        // The human body temperature [K]
+const float mu0 = 4 * pi * 1e-7;            // The magnetic permeability of vacuum [N/A²]
+const Real dt = 1. / 256;                   // Δt [τ_D]
+const float l = 1.e-4;                      // Average distance between adjacent superclusters in meninges
+const float l3 = pow(l, 3);                 // l³
+const float aNP = 8.5e-8;                   // The average radius of nanoparticles = 85 * 10⁻⁹ [m]
+const float eta = 0.69e-3;                  // Viscosity of cytoplasm [Pa.s]; 0.69 [mPa.s] for water in 37 ֯C
+const float tmax = 1.e6;                     // Maximum of simulation time [τ_D]
+const float zeta = NSC * 8 * pi *           // Random noise torque coefficient
+                   pow(aNP, 3) * eta;
+// λ is a unitless constant that compares magnetic energy with thermal fluctuation. The critical value of λ
+const float lambdaC = 1/(0.33+0.61/log10(N));
+const float lambdaMax = 12;                 // The maximum of λ
+const float tauD = zeta / (2 * kB * T);     // Debye relaxation time, ζ/(2k_B T) [s]
+const float m_lambda = 0.014                      // the slogan of variable lambda
+
+const Vec3 BDC0(0, 0, 0);                   // DC part of external magnetic field [B⁎]; in the initial part,
+const Vec3 BDC1(1, 0, 0);                   // and in the 2ⁿᵈ part of dynamics. note: 65 [µT] ~ 2100 [B⁎].
+const Vector3f a = lattice.a,               // Bases of the Bravais lattice
+               b = lattice.b;
+
+
+#define DATA 0
+// If DATA == 1, the snapshots are recorded.
+
+#define SNAPSHOT_CODEC 0
+// If SNAPSHOT_CODEC == 1, the snapshots of DATA == 1 are written in the compressed file snapshot<r>.rbz instead of
+// snapshot<r>.txt; see snapcode.h. The file is exported in the text format by snapdump.
+const double snapBound = 1e-3;              // maximum angular error of the compressed snapshots [rad]; 0 means
+                                            // lossless.
+const int snapKey = 100;                    // interval of the key frames of the compressed snapshots
+
+#define SNAPRING 0
+// If SNAPRING == 1, the snapshots are recorded in the ring file snapshot<r>.ring of a fixed size; see snapring.h.
+// The frames are dense near λc and sparse elsewhere, and the frames before each crossing of snapThreshold by
+// |〈μᵢ〉| are also kept. The ring file is exported in the text format by snapdump.
+const int snapCapacity = 2000;              // number of the frames of the ring file
+const int snapDense = 40,                   // interval of the frames [Δt] for |λ - λc| < snapWindow,
+          snapSparse = 400;                 // and elsewhere
+const float snapWindow = 0.2;
+const int snapHistory = 50,                 // number of the frames before a crossing which are kept
+          snapStride = 10;                  // interval of the frames of the history [Δt]
+const float snapThreshold = 0.5;            // threshold of |〈μᵢ〉| for the triggered capture
+
+#define DYNAMICS 0
+// If DYNAMICS == 0, the dynamics are simple without any change in external condition.
+// If DYNAMICS == 1, the dynamics are continuing after lambdaMax up to tMax.
+
+#define RESULTS 1
+// If RESULTS == 0, the results of each realization are written in result<r>.txt.
+// If RESULTS == 1, the results of all realizations are merged in ensemble.csv (ensemble<k>.csv for the shard k).
+// If RESULTS == 2, both of them are written.
+
+#define CORRELATION 1
+// If CORRELATION == 1, the correlation length ξ, S(0), S(q_min) and G(n a) for n = 0 ... L/2 are calculated by
+// the FFT and exported with the results; they are averaged over the sublattices of lattice.
+
+#define TOPOLOGY 1
+// If TOPOLOGY == 1, the numbers of vortices and antivortices of the in-plane orientations and the skyrmion number
+// and density of the orientations on the triangular plaquettes of each sublattice are exported with the results;
+// see topology.h.
+
+#define POLYDISPERSE 0
+// If POLYDISPERSE == 1, the radii aᵢ of the nanoparticles are drawn for each realization from a lognormal
+// distribution with the median aNP and the width sigmaA of ln(aᵢ/aNP). The moment of each dipole is
+// mᵢ = (aᵢ/aNP)³ [μSC], and its friction is ζᵢ ∝ (aᵢ + shell)³, where shell is the thickness of the coating;
+// so the relative rotational diffusion is Dᵢ = ((aNP + shell)/(aᵢ + shell))³, and τ_D of aNP is still the time
+// unit. The dipoles are the sources of the fields with mᵢμᵢ, and the step of each dipole is scaled by Dᵢ.
+const float sigmaA = 0.2;                   // width of the lognormal distribution of the radii
+const float shell = 0;                      // thickness of the coating of the nanoparticles [aNP]
+
+#define SEMI_IMPLICIT 1
+// If SEMI_IMPLICIT == 1, a step is semi-implicit as soon as the torque of the strongest field is stiff, i.e.
+// ½ Δt max|Bₜ| > stiffLimit (e.g. at large λ). The field Bₜ of the start of the step is frozen, and the torque
+// term is integrated exactly: the angle θ between μ and Bₜ follows dθ/dt = -½|Bₜ| sin θ, so
+//   tan(θ'/2) = tan(θ/2) exp(-½ Δt |Bₜ|)
+// for any Δt. The noise rotates μ by the angle |√Δt W| between two half relaxations (Strang splitting). So the
+// stiff alignment with Bₜ never overshoots, and |μ| == 1 without any normalization.
+const float stiffLimit = 0.1;
+
+#define MTS 0
+// If MTS == 1, the couplings are split into the near part (the sites closer than rNear) and the far part. The
+// near field and the mean field are calculated in each step, but the far field Σ_far J̃ᵢⱼ mⱼμⱼ is held and
+// refreshed every k steps. After each refresh, k is halved if the RMS change of the far field (relative to the
+// RMS of the dipolar field) is more than mtsTol, and it is doubled up to mtsKMax if it is less than mtsTol/2;
+// the change grows like √k, since it is mostly driven by the noise. The near couplings are copied to a sparse
+// list and zeroed in the dense Jtilda[][]; so they are stored twice, and the list (its size of each dipole is
+// written in the log) adds to the memory of Jtilda[][].
+const float rNear = 2;                      // range of the near couplings [l]
+const float mtsTol = 3e-2;
+const int mtsKMax = 16;
+
+#define ADAPTIVE_DT 0
+// If ADAPTIVE_DT == 1, the length h of each step is adapted by step doubling: a step h is compared with two steps
+// h/2 which are driven by the same increments of the Wiener process. The local error is the difference of their
+// torque terms, ¼ h Dᵢmᵢ |τᵢ(h/2) - τᵢ(0)| with τ = Bₜ - (μ·Bₜ)μ; the rest of the difference is the order of the
+// rotations of the noise, which does not depend on λ. The step is accepted if the RMS of the error over the
+// dipoles is less than dtTol, and the two steps h/2 are kept; otherwise, it is retried with a shorter h. The
+// increments of a rejected step are kept and split by the Brownian bridge for the next attempts (Brownian tree);
+// so the rejections do not bias the noise. In the disordered phase (small λ) the torques are weak and h grows up
+// to dtMax, and it shrinks only if the torques are large. The steps are counted in the simulated time: n steps
+// of executeSteps() (e.g. ceq of a λ step, or decorrelationSteps) are the accepted steps which cover n Δt, and
+// the λ steps, the samples and the exports of execute(rI) are counted on the grid of Δt; so the state after a
+// step is sampled once for each Δt of the grid in the step, i.e. it is weighted by h. The mean, minimum and
+// maximum of h and the number of the rejections of each λ step are exported with the results.
+const float dtTol = 2e-3;                   // tolerance of the RMS local error [rad]
+const Real dtMin = dt / 8,                  // range of h [τ_D]
+           dtMax = 16 * dt;
+
+#define SAMPLER 0
+// If SAMPLER == 1, the equilibrium states are sampled by Monte Carlo instead of the Brownian dynamics, with the
+// same observables and results; each step of executeSteps() is then a sweep, and t is the number of the sweeps.
+// A sweep is a heat-bath pass and overRelax over-relaxation passes over the dipoles, where the dipolar fields
+// are kept by a FieldTracker (the accepted moves are staged, and each trackBlock of them are added to the fields
+// in one pass over their rows of J̃; the fields are calculated again after trackRefresh sweeps of moves), and a
+// Hybrid MC update of all dipoles (hmcSteps leapfrog steps of hmcEps on the spheres) follows every hmcInterval
+// sweeps. The linear field of a move is the exact -∂(N λ e)/∂μᵢ of the others, i.e. with the symmetric mean
+// field ½(δJᵢ〈s〉 + 〈δJₖsₖ〉) of the sublattices, and the self coupling J̃ᵢᵢ, the self part of the mean field and
+// the extra field terms are corrected by the Metropolis test; so the states follow exp(-N λ e), where e is
+// magEnergy(). Bₜ[] is brought to the state after each sweep. A pass costs about one field calculation of a
+// step Δt, but it moves the dipoles much farther.
+const int overRelax = 2;                    // number of the over-relaxation passes of a sweep
+const int hmcInterval = 10;                 // interval of the Hybrid MC updates [sweeps]; 0 means no update.
+const int hmcSteps = 10;                    // number of the leapfrog steps of a Hybrid MC update
+const float hmcEps = 0.1;                   // length of the leapfrog steps
+const int trackRefresh = 10;                // interval of the full calculations of the tracked fields [sweeps]
+const int trackBlock = 32;                  // number of the accepted moves which are added to them in one pass
+
+#define WARM_START 0
+// If WARM_START == 1, the equilibrium states of executeHysteresis() at (λ₀, BDC0), of executeRotationalB() at
+// (λc, B₀), which are reached by the ramp of λ of execute(λ₁), and the ground state of -minimize are stored in
+// the state library statesDir; see statelib.h. The next realizations (and the next runs) start from the nearest
+// stored state of the same lattice and L within dLambdaWarm and dBWarm instead of equilibrating it again. A
+// loaded state is decorrelated by decorrelationSteps steps of the dynamics with the noise of the realization,
+// and each realization takes another state among the equally near ones if there are enough of them.
+const char* const statesDir = "states";
+const float dLambdaWarm = 0.05,             // tolerances of λ
+            dBWarm = 0.05;                  // and of |ΔB| [B⁎]
+const int decorrelationSteps = 2 * ceq;
+
+#define HISTOGRAM 0
+// If HISTOGRAM == 1, the energy histograms of the λ steps are recorded in histogram<r>.txt; see reweight.cpp.
+const double histdE = 1e-4;                 // width of the energy bins of the histograms
+
+#define OBSERVABLES 0
+// If OBSERVABLES == 1 (or 2), the observables of the pipeline are measured in their own intervals of the steps
+// and written in observables<r>.csv (or the binary observables<r>.bin); see observe.h. Each observable is a
+// reduction kernel over the sites, which is registered in init() by observables.add(); the due observables of a
+// state are evaluated in one pass, with Bₜ[] of the same state: the state after k steps (k = 0 is the initial
+// state) is measured as the step k at the start of the next step, where its fields are calculated anyway, and
+// with SAMPLER == 1 after the sweep k, which brings Bₜ[] to its state; so the Brownian dynamics do not measure
+// the last state of a realization.
+const long obsMagnetization = 1;            // intervals of the observables [steps]: 〈μᵢ〉 and |〈μᵢ〉|,
+const long obsEnergy = 10;                  // the energy e of magEnergy(),
+const long obsTorque = 100;                 // and the mean torque 〈|μᵢ × Bₜ[i]|〉
+
+#define CORRELATOR 0
+// If CORRELATOR == 1, 〈μᵢ〉 of each step of the stationary part of a realization (the field of DYNAMICS == 1, or
+// the rotation of executeRotationalB()) is added to a multiple-tau correlator (see correlator.h); the λ ramp is
+// not stationary, so nothing is recorded without such a part. At the end of the realization, C(τ) =
+// 〈M(t)·M(t+τ)〉 and its connected part are written in correlation<r>.csv, and χ(ω) = χ' - iχ'' of the
+// fluctuation-dissipation theorem in chi<r>.csv, where χ₀ = N C_c(0)/3 is the static susceptibility of a
+// component. τ and ω are in the units of t; so with SAMPLER == 1 they are in sweeps. The lags are counted in
+// steps, which must be uniform in t; so the adaptive steps of ADAPTIVE_DT == 1 cannot be correlated.
+#if (CORRELATOR == 1) && (ADAPTIVE_DT == 1) && (SAMPLER == 0)
+  #error CORRELATOR needs the uniform steps of a fixed dt; set ADAPTIVE_DT to 0.
+#endif
+
+// Parameters of the ground state of the -minimize switch; see findGroundState().
+const float minTol = 1e-4;                  // tolerance of the maximum torque |gᵢ - (μᵢ·gᵢ)μᵢ| of the gradient g [B⁎]
+const int minIterations = 20000;            // maximum number of the iterations of each minimization
+const int minRestarts = 4;                  // number of the simulated annealing restarts
+const int annealStages = 8;                 // number of the λ stages of each annealing, from λc to λₘₐₓ
+
+// Parameters of the field terms of Fields [B⁎]
+const float Ku = 0;                         // uniaxial anisotropy along easyAxis
+const Vector3f easyAxis(0, 0, 1);
+const float Kc = 0;                         // cubic anisotropy
+const float Jex = 0;                        // exchange coupling of the sites closer than rex [l]
+const float rex = 1;
+
+const static IOFormat CSVFormat(StreamPrecision, DontAlignCols, ", ", "\n");
+
+// Variables
+// =========
+double t;                                   // Current time in the simulation [τ_D]; a float t loses
+                                            // the resolution of dt long before tmax.
+long steps;                                 // Number of the time steps of the realization
+float lambda;                               // λ is a unitless constant which compares magnetic energy with
+                                            // thermal fluctuation
+float theta;                                // Angle of rotating magnetic field
+
+Vector3f* r;                                // Position of dipoles [l]
+Vec3* mu;                                   // Direction of magnetic moment of dipoles, where |μ[i]| == 1
+Vec3* source;                               // sources of the dipolar fields, mᵢμᵢ; source == mu if POLYDISPERSE == 0
+Real* moment;                               // mᵢ [μSC] of POLYDISPERSE == 1
+Real* drift;                                // ½ Δt Dᵢ mᵢ, the coefficient of the torque of the field in a step
+Real* noise;                                // √(Δt Dᵢ), the amplitude of the noise in a step
+BinderCumulant BC;                          // calculate the Binder's cumulant. It is gets samples and
+                                            // calculated in execute()!
+Jackknife JK(5);                            // samples of (|〈μᵢ〉|², |〈μᵢ〉|⁴, |〈μᵢ〉|, e, e²) in a λ step,
+                                            // where e is the magnetic energy; see sample().
+LogBinning M2Bins;                          // logarithmic binning of |〈μᵢ〉|² in a λ step
+EnergyHistogram H(histdE);                  // histogram of the magnetic energy in a λ step
+vector<Mat3> Jinf;                          // Jinf[s] = J_s(∞) = \lim_{R→∞} J_s(R) of the site s of the cell
+JStore** Jtilda;                            // Jtilda[i][j] shows the total coupling of the iᵗʰ
+                                            // dipole with all jᵗʰ dipoles in any cells.
+Mat3* dJ;                                   // \delta J[i] shows the reminder of interaction between
+                                            // the iᵗʰ dipole and the entire lattice out of the constant
+                                            // radius R in init().
+Vec3* BT;                                   // Bₜ[i] shows the total magnetic field at rᵢ [B⁎]
+Vec3* Bfar;                                 // the far field Σ_far J̃ᵢⱼ mⱼμⱼ of MTS == 1, without λ
+vector<int> nearFirst, nearIndex;           // the near sites of i are nearIndex[nearFirst[i] ... nearFirst[i+1])
+vector<JStore> nearJ;                       // and their couplings, which are zeroed in Jtilda[i][]
+int mtsK = 1,                               // refresh interval of Bfar[] [Δt]
+    mtsAge;                                 // number of the steps since the last refresh of Bfar[]
+long mtsRefreshes;                          // number of the refreshes of Bfar[] in the realization
+long stiffSteps;                            // number of the semi-implicit steps in the realization
+Real dtNow = dt;                            // h of the next step of ADAPTIVE_DT == 1 [τ_D]
+double tick;                                // t of the last counted Δt of ticks()
+Vec3 *muStart, *BStart;                     // μ[] and Bₜ[] at the start of an adaptive step
+Vec3 *dW1, *dW2;                            // increments of the Wiener process in the halves of an adaptive step
+struct Increment {                          // the increments W(t + h) - W(t) of all dipoles
+    double h;
+    vector<Vec3> W;
+};
+vector<Increment> pending;                  // the increments of the rejected steps; the next one is the last
+double dtSum;                               // Σh, minimum and maximum of h, the number of the steps and the
+Real dtLow, dtHigh;                         // rejections in the current λ step of ADAPTIVE_DT == 1
+long dtSteps, dtRejected;
+long rejections;                            // number of the rejected steps in the realization
+long mcTrials, mcAccepted;                  // single-dipole moves and Hybrid MC updates of SAMPLER == 1 in the
+long hmcTrials, hmcAccepted;                // realization
+FieldTracker<JStore, Vec3, Vec3F> tracker;  // Σⱼ J̃ᵢⱼ mⱼμⱼ of Jtilda[][] for SAMPLER == 1
+
+Vec3 BDC;                                   // DC part of external magnetic field [B⁎].
+bool checkPrecision = false;                // If it is true, init() compares the fields with the double
+                                            // precision reference; see the -precision switch.
+bool groundState = false;                   // If it is true, the ground state is found instead of the realizations;
+                                            // see the -minimize switch.
+bool numa = false;                          // If it is true, each OpenMP place (socket) reads its own replica of
+                                            // μ[] in calcBTotal(); see the -numa switch and numa.h.
+PlaceReplica<Vec3> muReplica;               // the replicas of source[] for numa
+Telemetry telemetry;                        // The progress is published to the reporter thread of telemetry,
+                                            // which writes it on the terminal and in the status file.
+
+// File stream
+// ============
+ofstream snapshot;                          // The position and magnetic moment of all particles are stored in
+                                            // the snapshot stream with the dict. format.
+ofstream res;                               // The result of simulation
+ofstream hist;                              // The energy histograms of the λ steps
+ObservablePipeline observables;             // The observables of OBSERVABLES != 0 and CORRELATOR == 1
+int obsM = -1;                              // index of 〈μᵢ〉 in observables
+MultiTauCorrelator correlator;              // C(τ) of 〈μᵢ〉 of CORRELATOR == 1
+bool correlating = false;                   // shows if the stationary part of the realization is recorded.
+SnapshotEncoder codec;                      // The snapshots of SNAPSHOT_CODEC == 1
+SnapshotRing ring;                          // The snapshots of SNAPRING == 1
+float ringM;                                // |〈μᵢ〉| of the previous step of snapshotStep()
+
+// Ensemble
+// ========
+EnsembleReducer ensemble;                   // running means and variances of the results of realizations
+int shard = 0,                              // This process runs the realizations r ≡ shard (mod nShards);
+    nShards = 1;                            // see the -shard switch.
+vector<string> resultNames;                 // names of the results which are exported by exportResult()
+SpinCorrelation corr;                       // G(r) and S(q) of the orientations
+Fields fields;                              // the extra field terms
+StateLibrary states;                        // the equilibrium states of WARM_START == 1
+long runSeed;                               // the initial seed of this process
+
+// ===== //
+void init();                                // Common initialization
+void done();                                // Common finalization
+
+void init(int rI);                          // Initializing the rIᵗʰ realization
+void done(int rI);                          // Finalization of rIᵗʰ realization
+
+// compares Bₜ[] and the magnetic energy of a random state with the double precision reference which is
+// calculated by dJtilda[][]. It helps to choose the cheapest PRECISION and COUPLING_STORAGE for a lattice.
+void precisionCheck(Matrix3d** dJtilda);
+
+string ensembleFile();                      // name of the consolidated file of this process
+string statusFile();                        // name of the status file of this process
+// merges the consolidated files files[1..n-1] in files[0]; returns 0 on success.
+int mergeEnsembles(int n, char* files[]);
+// merges the consolidated data of all MPI ranks in the file of rank 0.
+void gatherEnsembles(const string& file);
+
+Vec3 mu_avg();                              // Average of 〈μᵢ〉
+Vec3 source_avg();                          // Average of 〈mᵢμᵢ〉, the source of the mean field
+Vec3 dJ_avg();                              // Average of 〈δJᵢ mᵢμᵢ〉, the other half of the mean field of the energy
+// -∂(N λ e)/∂μᵢ of the state of Bₜ[]
+Vec3 energyField(int i);
+void updateSources();                       // updates source[] by μ[] of POLYDISPERSE == 1
+void extraField(int i, Vec3& B);            // adds the field of the extra terms per unit mᵢ to B.
+void drawDipoles();                         // draws mᵢ and Dᵢ of POLYDISPERSE == 1
+void splitCouplings();                      // copies the near couplings of MTS == 1 and zeroes them in Jtilda[][]
+template <typename V>
+Vec3F nearField(int i, const V* m);         // Σ_near J̃ᵢⱼ mⱼ of MTS == 1
+void calcBTotal();                          // calculates the total magnetic field by using the coupling tensor in
+                                            // the unit cell and mean field for the remainder of the lattice. Then
+                                            // it updates Bₜ[].
+double magEnergy();                         // calculates the total magnetic energy.
+double energyTerm(int i);                   // the term of the site i of 2 N λ magEnergy()
+void sample(const Vec3& M1);                // gets a sample of the observables, where M1 is 〈μᵢ〉.
+// the reduction kernels of the observable pipeline; see ObservablePipeline.
+void magnetizationSite(int i, double* acc);
+void magnetizationFinish(const double* acc, int n, double* out);
+void energySite(int i, double* acc);
+void energyFinish(const double* acc, int n, double* out);
+void torqueSite(int i, double* acc);
+void meanFinish(const double* acc, int n, double* out);
+void correlate(long step, double t, int k, const double* value); // adds 〈μᵢ〉 to the correlator.
+void exportCorrelation(int rI);             // writes C(τ) and χ(ω) of the realization.
+void initStat();                            // removes the samples of the observables.
+bool lambdaStepDone(int cLambda);           // shows if a λ step of cLambda steps is finished.
+
+// The derived quantities of the averages of the samples in JK
+double binderOf(const double* avg);         // Binder cumulant
+double chiOf(const double* avg);            // magnetic susceptibility, N (〈M²〉 - 〈|M|〉²)
+double heatOf(const double* avg);           // specific heat, N λ² (〈e²〉 - 〈e〉²)
+void execute();                             // approaching to equilibrium
+
+// simulates the system and changes λ from 0 to λₘₐₓ
+void execute(float lambda1);
+
+// simulates the system and increases λ from 0 to λₘₐₓ, where rI is a realization index.
+void execute(int rI);
+
+// Simulates a single hysteresis loop, where λ₀ = 3λc, ΔB shows the linear changes
+// in the external magnetic field in each step of simulation, B₀ shows the maximum
+// amplitude of external magnetic field, and rI is a realization index.
+void executeHysteresis(int rI, const Vec3 dB, const float B0 = 1, const float lambda0 = 3*lambdaC);
+
+// simulates a rotational external magnetic field, where B₀ shows
+// the amplitude of the magnetic field and rI is a realization index.
+void executeRotationalB(int rI, const float B0 = 1);
+
+// finds the ground state at λₘₐₓ and BDC0 by the L-BFGS minimizer with the simulated annealing restarts, and
+// writes it in groundstate.csv.
+void findGroundState();
+// the energy N λ e of the state x of findGroundState() and its exact gradient; see groundEnergy().
+double groundEnergy(const Vector3d* x, Vector3d* g);
+void exportGroundState(const string& file, double E); // writes the state and its energy e.
+
+// starts from the nearest stored state of (λ₁, B₁) and decorrelates it; it returns false if there is not any
+// such state (or WARM_START == 0).
+bool warmStart(int rI, float lambda1, const Vec3& B1);
+void storeState(int rI);                    // adds the current state to the state library of WARM_START == 1.
+
+void executeSingleStep();                   // executes a single time step.
+// the semi-implicit step of m in the field B with the noise W, where a and b are the coefficients of the torque
+// and the noise (½Δt and √Δt), and relax() is its exact relaxation in a constant field.
+Vec3 stiffStep(const Vec3& m, const Vec3& B, const Vec3& W, Real a, Real b);
+Vec3 relax(const Vec3& m, const Vec3& B, Real a);
+void executeSteps(int n);                   // executes n time steps in one parallel region.
+int ticks();                                // number of the Δt of the grid of t since the last call
+void sweep();                               // executes a Monte Carlo sweep of SAMPLER == 1.
+void hmcUpdate();                           // executes a Hybrid MC update of all dipoles.
+void trackedFields();                       // updates Bₜ[] from the tracked fields of SAMPLER == 1.
+Vec3 heatBath(const Vec3& K);               // a direction drawn from exp(K·μ)
+Mat3 selfCoupling(int i);                   // J̃ᵢᵢ
+Vec3 dipolarField(int i);                   // Σ_{j≠i} J̃ᵢⱼ mⱼμⱼ, the dipolar field of the others at i without λ
+double localEnergy(int i, const Vec3& m);   // the energy of μᵢ = m which is not linear in the field of the others
+void adaptiveStep();                        // executes an accepted step of ADAPTIVE_DT == 1.
+// moves μ[] from m[] in the fields B[] by the Wiener increments W[] in the time h; it returns true if the move
+// was semi-implicit.
+bool moveDipoles(const Vec3* m, const Vec3* B, const Vec3* W, Real h);
+void drawIncrement(double h, Vec3* W);      // the increments W[] of the next time h of the Brownian path
+void initHistory();                         // removes the history of h of ADAPTIVE_DT == 1.
+void exportHeader();                        // exports the header to the snapshot stream
+                                            // means exclude header.
+void exportResult(int id);                  // exports the current state to the res stream. θ shows the angle
+                                            // of external magnetic field.
+void exportSnapshot(int id);                // exports the current state to the snapshot stream,
+                                            // where id is the index of data block.
+Vector3f siteField(const Vector3f& r);      // the site field of SiteField at r [B⁎]
+void snapshotStep(long c, const Vec3& M1);  // records the cᵗʰ step in the snapshot ring if it is needed,
+                                            // where M1 is 〈μᵢ〉.
+
+// functions definition //
+// ==================== //
+int main (int argc, char *argv[]) { // Main routine
+
+    lout << "\nRotaional Brownian Motion, Ver 1.22\n"
+         << "Copyleft (ɔ) Nasim 2020-22, All lefts reserved!\n"
+         << "Date: 14010302" << endl;
+
+    init_mpiutils(&argc, &argv);            // initiates the MPI; a single rank without USE_MPI.
+    init_mtutils(max(1, 10 / mpiLocalSize));// initiates the OpenMP; the ranks of a machine share its cores.
+    // Note: Due to the simultaneous use of the SSE instruction set and OpenMP, and the competition between
+    // the SSE instructions set and the separate cores in using the floating-point units and cache, defining
+    // the maximum allowed value for the number of CPU cores in OpenMP may not be the best choice due to some
+    // overloads. The appropriate amount depends on the number of actual floating units available and the size of
+    // cache. For cheap processors, half of the number of CPU cores might be enough!
+
+    // manage the input switches
+    bool storeJinf = false;
+    for (int i = 1; i < argc; i++) {
+        const string sw(argv[i]);
+        if (sw == "-Jinf")
+            storeJinf = true;
+        else if (sw == "-precision")
+            checkPrecision = true;
+        else if (sw == "-minimize")         // finds the ground state instead of the realizations.
+            groundState = true;
+        else if (sw == "-numa")             // NUMA-aware calcBTotal(); bind the threads by OMP_PLACES=sockets.
+            numa = true;
+        else if ((sw == "-shard") && (i + 2 < argc)) { // -shard k n: runs the realizations r ≡ k (mod n)
+            shard   = atoi(argv[++i]);
+            nShards = atoi(argv[++i]);
+        } else if (sw == "-merge") {        // -merge out.csv in1.csv in2.csv ...
+            const int err = (mpiRank == 0) ? mergeEnsembles(argc - i - 1, argv + i + 1) : 0;
+            free_mtutils();
+            free_mpiutils();
+            return err;
+        }
+    }
+
+    // The MPI ranks divide the realizations of the shard; so the realizations of the rank k of the shard s are
+    // r ≡ s + k nShards (mod nShards mpiSize).
+    const string mergedFile = ensembleFile();
+    shard   += nShards * mpiRank;
+    nShards *= mpiSize;
+
+    // Randomize the pseudo-random number generator; the shards of a job array must not have the same seed.
+    if (nShards > 1)
+        randomize(int(time(NULL)) + 1009 * shard);
+    else
+        randomize();
+    runSeed = seed;
+    lout << "\nseed: " << seed << endl;
+
+    // Only the rank 0 stores J(∞), and then all ranks load it. The triangular lattice keeps the legacy J_inf.csv;
+    // the J_s(∞) of the other lattices are stored in J_inf_<id>.csv.
+    const string JinfFile = lattice.legacy() ? "J_inf.csv" : "J_inf_" + lattice.id() + ".csv";
+    vector<Matrix3d> JinfSites;
+    if ((mpiRank == 0) && (storeJinf || !IsFileExist(JinfFile.c_str()) ||
+                           (!lattice.legacy() && !Load_Jinf(lattice, JinfFile.c_str(), JinfSites)))) {
+        if (lattice.legacy())
+            Store_Jinf(a, b);
+        else
+            Store_Jinf(lattice, JinfFile.c_str());
+    }
+    mpiBarrier();
+
+    if (lattice.legacy()) {
+        // loads the estimation of J₁₁(∞) which is estimated by the subroutine Store_Jinf().
+        ifstream J_inf("J_inf.csv", std::ios_base::in);
+
+        // Reads the J₁₁(∞) from J_inf.txt
+        float J;
+        J_inf >> J;
+
+        // and initializes the Jinf.
+        Jinf.assign(1, Mat3::Zero());
+        Jinf[0] << J, 0, 0,
+                   0, J, 0,
+                   0, 0, -2 * J;
+    } else {
+        if (!Load_Jinf(lattice, JinfFile.c_str(), JinfSites)) {
+            lout << "Cannot read " << JinfFile << endl;
+            free_mtutils();
+            free_mpiutils();
+            return 1;
+        }
+        for (int s = 0; s < nSites; s++)
+            Jinf.push_back(JinfSites[s].cast<Real>());
+    }
+
+    // Introducing the parameters before beginning
+    lout << "unit cell: " << L << " x " << L << "\tNᵣ: " << NR
+         << "\nlattice: " << lattice.id() << "\t\tsites of the cell: " << nSites
+         << "\nT: "  << T << " [K]\t\tDC part of Bₑₓₜ: (" << BDC.transpose().format(CSVFormat) << ") [B⁎]"
+         << "\na: (" << a.transpose().format(CSVFormat) << ")\t\tb: (" << b.transpose().format(CSVFormat) << ')'
+         << setprecision(3)
+         << "\nτD: " << tauD << " [s]\t\tμSC: " << muSC << " [J/T or A.m²/kg]"
+         << "\nl: "  << l << "\t\tλc: " << lambdaC
+         << "\nb0 (intercept colding lambda): " << 1/(1.2 * N + 465.8)
+         << "\nm (slope for colding lambda): " << m_lambda
+         << "\nprecision: " << Policy::name() << "\t\tJ̃ storage: " << Storage::name() << endl;
+
+    // calculates the executing time of the main section of code.
+    lout.start();
+
+    // initialization
+    init();
+
+    if (nShards > 1)
+        lout << "shard: " << shard << " of " << nShards
+             << ((mpiSize > 1) ? "\tMPI rank: " + to_string(mpiRank) + " of " + to_string(mpiSize) : "") << endl;
+
+    if (groundState && (mpiRank == 0))
+        findGroundState();
+
+    for (int r = 1; (r <= NR) && !groundState; r++) { // A realization loop
+
+        if ((r - 1) % nShards != shard)
+            continue;
+
+        init(r);
+
+        // The following line could be used in the remote SSH running!!!
+        lout.echo(false);
+
+        // Uncomment one of the following lines according to the simulation plan: //
+        execute(r);
+        //executeHysteresis(r, Vec3(0.01, 0, 0), 1);
+        //executeRotationalB(r, 1);
+
+        // The following line could be used in the remote SSH running!!!
+        lout.echo(mpiRank == 0);
+
+        done(r);
+
+ 	    lout << "Execution of the " + to_string(r) + "ᵗʰ realization is Finished!" << endl;
+    }
+
+    #if RESULTS != 0
+        if ((mpiSize > 1) && !groundState)
+            gatherEnsembles(mergedFile);
+    #endif
+
+    done();
+
+    // calculates the executing time of the main section of code.
+    lout.stop();
+
+    lout << "Finish!" << endl;
+
+    if (mpiRank == 0)
+        wait();
+
+    free_mtutils();
+    free_mpiutils();
+
+    return 0;
+}
+
+void init() { // Common initialization of all realizations
+
+    const char* names[] = {"lambda", "time", "theta", "Total Magnetic Energy", "Magnetization",
+        "Binder Cumulant", "Binder Cumulant Error", "Susceptibility", "Susceptibility Error", "Specific Heat",
+        "Specific Heat Error", "Samples", "tau_int", "B.x", "B.y", "B.z", "Mp", "Mx", "My", "Mz"};
+    resultNames.assign(names, names + sizeof(names) / sizeof(names[0]));
+
+    #if CORRELATION == 1
+        corr.init(L, L, a, b);
+        resultNames.push_back("xi");
+        resultNames.push_back("S(0)");
+        resultNames.push_back("S(qmin)");
+        for (int n = 0; n <= L / 2; n++)
+            resultNames.push_back("G(" + to_string(n) + ")");
+    #endif
+
+    #if TOPOLOGY == 1
+        resultNames.push_back("Vortices");
+        resultNames.push_back("Antivortices");
+        resultNames.push_back("Skyrmion Number");
+        resultNames.push_back("Skyrmion Density");
+    #endif
+
+    #if ADAPTIVE_DT == 1
+        resultNames.push_back("dt");
+        resultNames.push_back("dt min");
+        resultNames.push_back("dt max");
+        resultNames.push_back("Rejections");
+    #endif
+
+    ensemble.init(resultNames);
+
+    // The correlator needs 〈μᵢ〉 of each step.
+    #if (OBSERVABLES != 0) || (CORRELATOR == 1)
+        obsM = observables.add("M", {"x", "y", "z", "norm"}, 3, (CORRELATOR == 1) ? 1 : obsMagnetization,
+                               magnetizationSite, magnetizationFinish);
+    #endif
+    #if OBSERVABLES != 0
+        observables.add("e", {"value"}, 1, obsEnergy, energySite, energyFinish);
+        observables.add("torque", {"mean"}, 1, obsTorque, torqueSite, meanFinish);
+    #endif
+    #if CORRELATOR == 1
+        observables.addSink(correlate);
+    #endif
+
+    #if WARM_START == 1
+        if (!states.open(statesDir))
+            lout << "Cannot open the state library " << statesDir << endl;
+    #endif
+
+    r  = new Vector3f[N];
+    mu = new Vec3[N];
+    BT = new Vec3[N];
+    dJ = new Mat3[N];
+    #if MTS == 1
+        Bfar = new Vec3[N];
+    #endif
+    #if ADAPTIVE_DT == 1
+        muStart = new Vec3[N];
+        BStart  = new Vec3[N];
+        dW1 = new Vec3[N];
+        dW2 = new Vec3[N];
+    #endif
+    #if POLYDISPERSE == 1
+        source = new Vec3[N];
+        moment = new Real[N];
+        drift  = new Real[N];
+        noise  = new Real[N];
+    #else
+        source = mu;
+    #endif
+
+    // The arrays of the sites are first touched with the static schedule of calcBTotal() and
+    // executeSingleStep(); so on a NUMA machine, the slab of each thread is in the memory of its socket.
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; i++) {
+        mu[i] = Vec3::Zero();
+        BT[i] = Vec3::Zero();
+        dJ[i] = Mat3::Zero();
+        #if MTS == 1
+            Bfar[i] = Vec3::Zero();
+        #endif
+        #if ADAPTIVE_DT == 1
+            muStart[i] = BStart[i] = dW1[i] = dW2[i] = Vec3::Zero();
+        #endif
+        #if POLYDISPERSE == 1
+            source[i] = Vec3::Zero();
+            moment[i] = 1;
+            drift[i]  = 0.5 * dt;
+            noise[i]  = sqrt(dt);
+        #endif
+    }
+
+    // Initializing the lattice points; the sites of the cell (i, j) are consecutive; see lattice.h.
+    int k = 0;
+    for (int i = 0; i < L; i++)
+        for (int j = 0; j < L; j++)
+            for (int s = 0; s < nSites; s++)
+                r[k++] = i * a + j * b + lattice.site(s);
+
+    if ( L <= 3) { // Following lines show points of a small lattice
+        int k = 0;
+        for (int i = 0; i < L; i++)
+            for (int j = 0; j < L; j++)
+                for (int s = 0; s < nSites; s++) {
+                    lout << "i: " << i << '\t'
+                         << "j: " << j << '\t'
+                         << "s: " << s << '\t'
+                         << "ia + jb + rₛ = [" << r[k++].transpose().format(CSVFormat) << ']' << endl;
+                }
+    }
+    FieldSetup setup = {N, r, L * a, L * b, Ku, easyAxis, Kc, Jex, rex, siteField};
+    fields.init(setup);
+    if (Fields::size > 0)
+        lout << "field terms: " << fields.names() << endl;
+
+    // Jtilta is calculated for a triangular lattice of radius R
+    const int R = 500;
+    const float RMax = R * sin(pi/3);
+
+    // Allocating the temporary memory for double precision dJtilda; the rows are contiguous for MPI.
+    Matrix3d** dJtilda  = new Matrix3d*[N];
+    dJtilda[0] = new Matrix3d[N * N];
+    for (int i=0; i < N; i++) {
+        dJtilda[i] = dJtilda[0] + i * N;
+        for (int j=0; j < N; j++)
+            dJtilda[i][j] = Matrix3d::Zero();
+    }
+
+    // Computing the couplings with double precision in dJtilda[][]; each MPI rank computes a block of rows,
+    // and then the blocks are exchanged.
+    // The images of each pair are summed by a CouplingBatch of the thread. Only the images (k, l) with
+    // |k|, |l| <= M can be in the cutoff, where h is the shortest height of the supercell.
+    const float h = L * a.cross(b).norm() / max(a.norm(), b.norm());
+    int iBegin, iEnd;
+    mpiBlock(N, iBegin, iEnd);
+    #pragma omp parallel
+    {
+        CouplingBatch batch(RMax);          // Increase the symmetry of calculation; only d² <= RMax is included.
+        #pragma omp for schedule(dynamic)
+        for (int i = iBegin; i < iEnd; i++)
+            for (int j = 0; j < N; j++) {
+                const Vector3f d0 = r[j] - r[i];
+                const int M = min(R/L, int(ceil((sqrt(RMax) + d0.norm()) / h)));
+                for (int k = -M; k <= M; k++)
+                    for (int l = -M; l <= M; l++)
+                        batch.add(d0 + L*k*a + L*l*b);
+                dJtilda[i][j] = batch.sum();
+                batch.clear();
+            }
+    }
+    mpiAllgatherRows(dJtilda[0]->data(), N, 9 * N);
+
+    // Assign dJtilda[][] to Jtilda[][]; each row is allocated and first touched by the thread of calcBTotal().
+    Jtilda  = new JStore*[N];
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; i++) {
+        Jtilda[i] = new JStore[N];
+        for (int j = 0; j < N; j++)
+            Jtilda[i][j] = dJtilda[i][j].cast<Real>();
+    }
+
+    if (numa) {
+        muReplica.init(N);
+        lout << "NUMA: " << muReplica.places() << " replicas of μ" << endl;
+    }
+
+    // Calculating the difference of Jtilda and J(∞) and assign it to dJ[]
+    for (int i = 0; i < N; i++) {
+        Matrix3d JTotal = Matrix3d::Zero();
+        for (int j = 0; j < N; j++)
+            JTotal += dJtilda[i][j];
+        dJ[i] = Jinf[i % nSites] - JTotal.cast<Real>();
+    }
+
+    #if MTS == 1
+        splitCouplings();
+    #endif
+    tracker.init(Jtilda, N, long(trackRefresh) * (overRelax + 1) * N, trackBlock);
+
+    if (checkPrecision)
+        precisionCheck(dJtilda);
+
+    // Deallocating the temporary memory of dJtilda
+    delete[] dJtilda[0];
+    delete[] dJtilda;
+}
+
+void precisionCheck(Matrix3d** dJtilda) { // compares Bₜ[] and the magnetic energy with the double precision
+                                           // reference.
+    lambda = 1;
+    BDC = Vec3::Zero();
+    for (int i = 0; i < N; i++)
+        mu[i] = rndDir().cast<Real>();
+    updateSources();
+
+    calcBTotal();
+
+    Vector3d mu_MF = Vector3d::Zero(), nu = Vector3d::Zero();
+    for (int i = 0; i < N; i++) {
+        mu_MF += source[i].cast<double>();
+        nu    += dJ[i].cast<double>() * source[i].cast<double>();
+    }
+    mu_MF /= N;
+    nu    /= N;
+
+    double dBMax = 0, BMax = 0, E = 0, ERef = 0;
+    for (int i = 0; i < N; i++) {
+        Vector3d B = 0.5 * (dJ[i].cast<double>() * mu_MF + nu);
+        for (int j = 0; j < N; j++)
+            B += dJtilda[i][j] * source[j].cast<double>();
+        Vec3 X = Vec3::Zero();
+        extraField(i, X);
+        B += X.cast<double>();
+
+        dBMax = max(dBMax, (BT[i].cast<double>() - B).norm());
+        BMax  = max(BMax, B.norm());
+        E    -= source[i].cast<double>().dot(BT[i].cast<double>());
+        ERef -= source[i].cast<double>().dot(B);
+    }
+
+    lout << "\nPrecision check (" << Policy::name() << ", J̃ storage: " << Storage::name() << ")"
+         << scientific << setprecision(2)
+         << "\nmax|ΔBₜ| / max|Bₜ|: " << dBMax / BMax
+         << "\t|ΔE| / |E|: " << fabs(E - ERef) / fabs(ERef)
+         << resetiosflags(std::ios_base::floatfield | std::ios_base::showpoint)
+         << setprecision(-1) << endl;
+}
+
+Vector3f siteField(const Vector3f& r) { // the site field of SiteField at r [B⁎]
+    return Vector3f::Zero();
+}
+
+string ensembleFile() { // name of the consolidated file of this process
+    return (nShards > 1) ? "ensemble" + to_string(shard) + ".csv" : "ensemble.csv";
+}
+
+string statusFile() { // name of the status file of this process
+    return (nShards > 1) ? "status" + to_string(shard) + ".json" : "status.json";
+}
+
+int mergeEnsembles(int n, char* files[]) { // merges the consolidated files files[1..n-1] in files[0].
+
+    if (n < 2) {
+        lout << "Usage: rbm -merge out.csv in1.csv in2.csv ..." << endl;
+        return 1;
+    }
+
+    EnsembleReducer total, part;
+    for (int i = 1; i < n; i++) {
+        if (!part.load(files[i])) {
+            lout << "Cannot read " << files[i] << endl;
+            return 1;
+        }
+        if (!total.merge(part)) {
+            lout << files[i] << " has different observables." << endl;
+            return 1;
+        }
+    }
+
+    if (!total.save(files[0])) {
+        lout << "Cannot write " << files[0] << endl;
+        return 1;
+    }
+    lout << n - 1 << " files are merged in " << files[0] << endl;
+    return 0;
+}
+
+void gatherEnsembles(const string& file) { // merges the consolidated data of all MPI ranks in rank 0.
+
+    ostringstream os;
+    ensemble.write(os);
+    const vector<string> parts = mpiGather(os.str());
+    if (mpiRank != 0)
+        return;
+
+    EnsembleReducer total, part;
+    for (size_t k = 0; k < parts.size(); k++) {
+        istringstream is(parts[k]);
+        if (!part.read(is) || !total.merge(part)) {
+            lout << "The data of the rank " << k << " cannot be merged." << endl;
+            return;
+        }
+    }
+
+    if (!total.save(file))
+        lout << "Cannot write " << file << endl;
+    else
+        lout << "The data of " << parts.size() << " ranks is merged in " << file << endl;
+}
+
+void done() { // Common finalization
+
+    delete[] r;
+    delete[] mu;
+    delete[] BT;
+    #if MTS == 1
+        delete[] Bfar;
+    #endif
+    #if ADAPTIVE_DT == 1
+        delete[] muStart;
+        delete[] BStart;
+        delete[] dW1;
+        delete[] dW2;
+    #endif
+    delete[] dJ;
+    #if POLYDISPERSE == 1
+        delete[] source;
+        delete[] moment;
+        delete[] drift;
+        delete[] noise;
+    #endif
+
+    for (int i = 0; i < N; i++)
+        delete[] Jtilda[i];
+    delete[] Jtilda;
+}
+
+void init(int rI) { // Initializing the rIᵗʰ realization
+
+    t = 0;
+    steps = 0;
+    lambda = 0.1;
+    // First value of changing angle
+    theta = 0;
+    // DC magnetic field in the 1ˢᵗ part of dynamics.
+    BDC = BDC0;
+
+    // Initializing {μᵢ} with random direction
+    for (int i = 0; i < N; i++) {
+        mu[i] = rndDir().cast<Real>();
+    }
+    #if POLYDISPERSE == 1
+        drawDipoles();
+    #endif
+    updateSources();
+    mtsAge = mtsK;                          // Bfar[] of the previous realization is not valid.
+    mtsRefreshes = 0;
+    stiffSteps = 0;
+    dtNow = dt;                             // The path of the previous realization is not continued.
+    tick = 0;
+    pending.clear();
+    rejections = 0;
+    initHistory();
+    mcTrials = mcAccepted = hmcTrials = hmcAccepted = 0;
+    tracker.updates = tracker.refreshes = 0;
+    // Initial value of Binder cumulant.
+    BC.init();
+    initStat();
+
+    // If SNAPSHOT_CODEC == 1, snapshot is not opened and the outputs to snapshot are ignored.
+    #if (DATA == 1) && (SNAPSHOT_CODEC == 1)
+        if (!codec.open("snapshot" + to_string(rI) + ".rbz", N, snapBound, snapKey))
+            lout << "Cannot write snapshot" << rI << ".rbz" << endl;
+    #elif DATA == 1
+        snapshot.open("snapshot" + to_string(rI) + ".txt", std::ios_base::out | std::ios_base::trunc);
+        exportHeader();
+    #endif
+
+    #if SNAPRING == 1
+        if (!ring.open("snapshot" + to_string(rI) + ".ring", N, snapCapacity, snapHistory))
+            lout << "Cannot write snapshot" << rI << ".ring" << endl;
+        ringM = -1;
+    #endif
+
+    // If RESULTS == 1, res is not opened and the outputs to res are ignored.
+    #if RESULTS != 1
+        res.open("result" + to_string(rI) + ".txt", std::ios_base::out | std::ios_base::trunc);
+        res << setprecision(3) << "{" << "\"result\": {" << endl;
+    #endif
+
+    #if HISTOGRAM == 1
+        hist.open("histogram" + to_string(rI) + ".txt", std::ios_base::out | std::ios_base::trunc);
+        H.N = N;
+    #endif
+
+    correlator.reset();
+    correlating = false;
+    #if OBSERVABLES == 1
+        observables.openText("observables" + to_string(rI) + ".csv");
+    #elif OBSERVABLES == 2
+        observables.openBinary("observables" + to_string(rI) + ".bin");
+    #endif
+
+    telemetry.start(rI, statusFile(), mpiRank == 0);
+}
+
+void done(int rI) { // Finalization of rIᵗʰ realization
+
+    telemetry.stop();
+
+    #if DATA == 1
+        snapshot.close();
+    #endif
+
+    #if (DATA == 1) && (SNAPSHOT_CODEC == 1)
+        codec.close();
+        lout << "snapshot" << rI << ".rbz: " << codec.bytes() << " bytes, " << codec.bits() << " bits per coordinate, "
+             << "maximum angular error " << codec.maxError() << " [rad]" << endl;
+    #endif
+
+    #if SNAPRING == 1
+        ring.close();
+    #endif
+
+    #if SEMI_IMPLICIT == 1
+        lout << "semi-implicit steps: " << stiffSteps << " of " << steps << endl;
+    #endif
+
+    #if SAMPLER == 1
+        lout << "Monte Carlo: " << setprecision(3) << 100. * mcAccepted / max(mcTrials, 1L)
+             << "% of the single-dipole moves and " << 100. * hmcAccepted / max(hmcTrials, 1L) << "% of "
+             << hmcTrials << " Hybrid MC updates are accepted." << setprecision(-1) << endl;
+        lout << "tracked fields: " << tracker.updates << " row updates and " << tracker.refreshes
+             << " full calculations" << endl;
+    #endif
+
+    #if ADAPTIVE_DT == 1
+        lout << "adaptive dt: " << steps << " steps, mean dt = " << setprecision(3) << t / max(steps, 1L)
+             << ", " << rejections << " rejections" << setprecision(-1) << endl;
+    #endif
+
+    #if MTS == 1
+        lout << "MTS: far field refreshed every " << setprecision(3) << double(steps) / max(mtsRefreshes, 1L)
+             << " steps on average, k = " << mtsK << setprecision(-1) << endl;
+    #endif
+
+    res.close();
+
+    #if HISTOGRAM == 1
+        hist.close();
+    #endif
+
+    observables.close();
+
+    #if CORRELATOR == 1
+        if (correlating)
+            exportCorrelation(rI);
+        else
+            lout << "correlator: the realization has no stationary part; C(τ) and χ(ω) are not written." << endl;
+    #endif
+
+    #if RESULTS != 0
+        ensemble.finish();
+        if (!ensemble.save(ensembleFile()))
+            lout << "Cannot write " << ensembleFile() << endl;
+    #endif
+}
+
+Vec3 mu_avg() { // Average of 〈μᵢ〉
+
+    Sum<Vec3A, Policy::compensated> S;
+    for (int i = 0; i < N; i++)
+        S += mu[i].cast<accum>();
+
+    return (S.value() / N).cast<Real>();
+}
+
+Vec3 source_avg() { // Average of 〈mᵢμᵢ〉, the source of the mean field
+
+    Sum<Vec3A, Policy::compensated> S;
+    for (int i = 0; i < N; i++)
+        S += source[i].cast<accum>();
+
+    return (S.value() / N).cast<Real>();
+}
+
+Vec3 dJ_avg() { // Average of 〈δJᵢ mᵢμᵢ〉, the other half of the mean field of the energy
+
+    // δJᵢ is symmetric like J̃ᵢⱼ; so Σᵢ sᵢ·δJᵢ〈s〉 = N 〈δJᵢ sᵢ〉·〈s〉.
+    Sum<Vec3A, Policy::compensated> S;
+    for (int i = 0; i < N; i++)
+        S += (dJ[i] * source[i]).cast<accum>();
+
+    return (S.value() / N).cast<Real>();
+}
+
+void updateSources() { // updates source[] by μ[] of POLYDISPERSE == 1
+    #if POLYDISPERSE == 1
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < N; i++)
+            source[i] = moment[i] * mu[i];
+    #endif
+}
+
+void extraField(int i, Vec3& B) { // adds the field of the extra terms per unit mᵢ to B.
+
+    // The step of μᵢ is driven by mᵢBₜ[i]; so Bₜ[i] has -(1/mᵢ) ∂/∂μᵢ of the energy Σₖ mₖEₖ of POLYDISPERSE == 1,
+    // where a bond is weighted by ½(mᵢ + mⱼ).
+    #if POLYDISPERSE == 1
+        Vec3 Xm = Vec3::Zero();
+        fields.field(i, mu, moment, Xm);
+        B += Xm / moment[i];
+    #else
+        fields.field(i, mu, B);
+    #endif
+}
+
+void drawDipoles() { // draws mᵢ and Dᵢ of POLYDISPERSE == 1
+    #if POLYDISPERSE == 1
+        double mAvg = 0, DAvg = 0;
+        for (int i = 0; i < N; i++) {
+            const double x = exp(sigmaA * rndN()); // aᵢ/aNP
+            const double D = pow((1 + shell) / (x + shell), 3);
+            moment[i] = pow(x, 3);
+            drift[i]  = 0.5 * dt * D * moment[i];
+            noise[i]  = sqrt(dt * D);
+            mAvg += moment[i] / N;
+            DAvg += D / N;
+        }
+        lout << "〈mᵢ〉: " << mAvg << "\t〈Dᵢ〉: " << DAvg << endl;
+    #endif
+}
+
+void splitCouplings() { // copies the near couplings of MTS == 1 and zeroes them in Jtilda[][]
+
+    // The near sites are found by the nearest periodic image, and the self-coupling J̃ᵢᵢ of the images is near.
+    const float r2 = sqr(rNear);
+    nearFirst.assign(1, 0);
+    nearIndex.clear();
+    nearJ.clear();
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            bool near = false;
+            for (int k = -1; k <= 1; k++)
+                for (int l = -1; l <= 1; l++)
+                    near = near || ((r[j] - r[i] + L*k*a + L*l*b).squaredNorm() <= r2);
+            if (near) {
+                nearIndex.push_back(j);
+                nearJ.push_back(Jtilda[i][j]);
+                Jtilda[i][j] = Mat3(Mat3::Zero());
+            }
+        }
+        nearFirst.push_back(nearIndex.size());
+    }
+    lout << "MTS: " << double(nearIndex.size()) / N << " near couplings of each dipole" << endl;
+}
+
+template <typename V>
+Vec3F nearField(int i, const V* m) { // Σ_near J̃ᵢⱼ mⱼ of MTS == 1
+
+    Vec3F B = Vec3F::Zero();
+    for (int k = nearFirst[i]; k < nearFirst[i + 1]; k++)
+        B += (nearJ[k] * m[nearIndex[k]]).template cast<Policy::field>();
+    return B;
+}
+
+void calcBTotal() { // calculates the total magnetic field by using the coupling tensor in the unit cell
+                    // and mean field for the remainder of the lattice. Then it updates Bₜ[].
+
+    // The mean field ½(δJᵢ〈s〉 + 〈δJₖsₖ〉) is -∂/∂sᵢ of the mean field energy of magEnergy(); δJᵢ of the
+    // sublattices differ, and on a lattice of one site it is δJ〈s〉.
+    const Vec3 mu_MF = source_avg(), nu = dJ_avg();
+
+    if (numa) {
+        #pragma omp parallel
+        {
+            // Each place reads the sources from its own replica.
+            muReplica.refresh(source);
+            #pragma omp barrier
+            const Vec3* m = muReplica.local();
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < N; i++) {
+                Vec3F BDs = Vec3F::Zero();
+                for (int j = 0; j < N; j++)
+                    BDs += (Jtilda[i][j] * m[j]).template cast<Policy::field>();
+                #if MTS == 1
+                    Bfar[i] = BDs.cast<Real>();
+                    BDs += nearField(i, m);
+                #endif
+                Vec3 B = BDC + lambda * (BDs.cast<Real>() + 0.5 * (dJ[i] * mu_MF + nu));
+                extraField(i, B);
+                BT[i] = B;
+            }
+        }
+        mtsAge = 0;
+        return;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; i++) {
+        // Total net magnetic field produced by dipoles at rᵢ
+        Vec3F BDs = Vec3F::Zero();
+
+        for (int j = 0; j < N; j++) {
+            BDs += (Jtilda[i][j] * source[j]).template cast<Policy::field>();
+        }
+        #if MTS == 1                        // the far field is refreshed too.
+            Bfar[i] = BDs.cast<Real>();
+            BDs += nearField(i, source);
+        #endif
+        Vec3 B = BDC + lambda * (BDs.cast<Real>() + 0.5 * (dJ[i] * mu_MF + nu));
+        extraField(i, B);                   // the extra terms in the same pass
+        BT[i] = B;
+    }
+    mtsAge = 0;
+}
+
+double magEnergy() { // calculates the total magnetic energy.
+
+    Sum<accum, Policy::compensated> S;
+    //#pragma omp parallel for reduction (+: S) WHY?
+
+    for(int i = 0; i < N; i++)
+        S += accum(energyTerm(i));
+
+    return 0.5 * S.value() / (N * lambda);
+}
+
+double energyTerm(int i) { // the term of the site i of 2 N λ magEnergy()
+
+    // S -= mu[i].dot(BDC) + 0.5 * mu[i].dot(BT[i] - BDC);
+    // Current line multiple 0.5 is derived from the previous equation.
+    // The fields X of the extra terms are not dipolar; so their own energies replace them. mᵢX is their
+    // part of mᵢBₜ[i], and each dipole feels them with its moment mᵢ.
+    Vec3 X = Vec3::Zero();
+    extraField(i, X);
+    #if POLYDISPERSE == 1
+        const Real m = moment[i];
+    #else
+        const Real m = 1;
+    #endif
+    return -double(source[i].dot(BDC + BT[i] - X)) + double(2 * m * fields.energy(i, mu));
+}
+
+void magnetizationSite(int i, double* acc) { // Σ μᵢ
+    for (int c = 0; c < 3; c++)
+        acc[c] += mu[i][c];
+}
+
+void magnetizationFinish(const double* acc, int n, double* out) { // 〈μᵢ〉 and |〈μᵢ〉|
+    for (int c = 0; c < 3; c++)
+        out[c] = acc[c] / n;
+    out[3] = sqrt(sqr(out[0]) + sqr(out[1]) + sqr(out[2]));
+}
+
+void energySite(int i, double* acc) { // the term of the site i of magEnergy()
+    acc[0] += energyTerm(i);
+}
+
+void energyFinish(const double* acc, int n, double* out) { // e
+    out[0] = 0.5 * acc[0] / (n * lambda);
+}
+
+void torqueSite(int i, double* acc) { // |μᵢ × Bₜ[i]|
+    acc[0] += mu[i].cross(BT[i]).norm();
+}
+
+void meanFinish(const double* acc, int n, double* out) { // the mean of the sites
+    out[0] = acc[0] / n;
+}
+
+void correlate(long, double, int k, const double* value) { // adds 〈μᵢ〉 to the correlator.
+    if (correlating && (k == obsM))
+        correlator.add(value);
+}
+
+void exportCorrelation(int rI) { // writes C(τ) and χ(ω) of the realization.
+
+    const double h = (SAMPLER == 1) ? 1 : dt;       // the time of a step
+    vector<long> lag, count;
+    vector<double> C, Cc;
+    correlator.correlation(lag, C, Cc, count);
+    ofstream out(("correlation" + to_string(rI) + ".csv").c_str(), std::ios_base::out | std::ios_base::trunc);
+    out << setprecision(10) << "tau, C, C connected, samples\n";
+    for (size_t k = 0; k < lag.size(); k++)
+        out << lag[k] * h << ", " << C[k] << ", " << Cc[k] << ", " << count[k] << '\n';
+    out.close();
+
+    vector<double> omega;
+    vector<complex<double> > chi;
+    if (!correlator.susceptibility(h, omega, chi)) {
+        lout << "correlator: " << correlator.samples() << " samples without any fluctuation" << endl;
+        return;
+    }
+    const double chi0 = N * Cc[0] / 3;
+    out.open(("chi" + to_string(rI) + ".csv").c_str(), std::ios_base::out | std::ios_base::trunc);
+    out << setprecision(10) << "omega, chi', chi''\n";
+    out << 0 << ", " << chi0 << ", " << 0 << '\n';
+    for (size_t k = 0; k < omega.size(); k++)
+        out << omega[k] << ", " << chi0 * chi[k].real() << ", " << -chi0 * chi[k].imag() << '\n';
+    lout << "correlator: " << correlator.samples() << " samples, τ up to " << lag.back() * h << ", χ₀ = "
+         << chi0 << endl;
+}
+
+void sample(const Vec3& M1) { // gets a sample of the observables, where M1 is 〈μᵢ〉.
+
+    const double M2 = M1.squaredNorm();
+    const double e = magEnergy();
+    const double x[5] = {M2, sqr(M2), sqrt(M2), e, sqr(e)};
+
+    BC.sample(M2);
+    JK.sample(x);
+    M2Bins.sample(M2);
+
+    #if HISTOGRAM == 1
+        H.sample(e, M2);
+    #endif
+}
+
+void initStat() { // removes the samples of the observables.
+
+    JK.init();
+    M2Bins.init();
+    H.init();
+}
+
+bool lambdaStepDone(int cLambda) { // shows if a λ step of cLambda steps is finished.
+
+    if (cLambda >= ceq)
+        return true;
+
+    if ((BCErrMax > 0) && (cLambda >= ceqMin)) {
+        double err;
+        JK.estimate(binderOf, err);
+        return (err > 0) && (err < BCErrMax);
+    }
+    return false;
+}
+
+double binderOf(const double* avg) { // Binder cumulant
+    return (avg[0] > 0) ? 1. - 3. * avg[1] / (5. * sqr(avg[0])) : 0;
+}
+
+double chiOf(const double* avg) { // magnetic susceptibility
+    return N * (avg[0] - sqr(avg[2]));
+}
+
+double heatOf(const double* avg) { // specific heat
+    return N * sqr(lambda) * (avg[4] - sqr(avg[3]));
+}
+
+void findGroundState() { // finds the ground state at λₘₐₓ and BDC0.
+
+    // The first minimization starts from random orientations. Each restart anneals the best state by the
+    // dynamics from λc to λₘₐₓ in annealStages stages of ceq steps, and then minimizes it again.
+    t = 0;
+    steps = 0;
+    BDC = BDC0;
+    mtsAge = mtsK;
+    #if POLYDISPERSE == 1
+        drawDipoles();
+    #endif
+    SphereLBFGS lbfgs(10 * numeric_limits<Real>::epsilon()); // the resolution of the energies of Real
+    vector<Vector3d> x(N), best(N);
+    double EBest = 0;
+
+    lout << "\nground state at λ = " << lambdaMax << endl;
+    for (int k = 0; k <= minRestarts; k++) {
+        if (k == 0) {
+            for (int i = 0; i < N; i++)
+                mu[i] = rndDir().cast<Real>();
+        } else {
+            for (int i = 0; i < N; i++)
+                mu[i] = best[i].cast<Real>();
+            updateSources();
+            for (int c = 0; c < annealStages; c++) {
+                lambda = lambdaC * pow(lambdaMax / lambdaC, c / (annealStages - 1.));
+                executeSteps(ceq);
+            }
+        }
+        lambda = lambdaMax;
+        for (int i = 0; i < N; i++)
+            x[i] = mu[i].cast<double>().normalized();
+
+        const MinimizeResult R = lbfgs.minimize(&x[0], N, groundEnergy, minTol, minIterations);
+        const double e = R.E / (N * lambda);
+        lout << (k == 0 ? "random start" : "restart " + to_string(k)) << ": e = " << setprecision(8) << e
+             << setprecision(3) << "\tmax torque: " << R.torque << " [B⁎]\titerations: " << R.iterations
+             << "\tfields: " << R.evaluations << (R.converged ? "" : "\tnot converged") << setprecision(-1)
+             << endl;
+        if ((k == 0) || (e < EBest)) {
+            EBest = e;
+            best = x;
+        }
+    }
+
+    groundEnergy(&best[0], &x[0]);          // μ[] and Bₜ[] of the best state
+    exportGroundState("groundstate.csv", magEnergy());
+    lout << "ground state: e = " << setprecision(8) << magEnergy() << setprecision(-1)
+         << ", |〈μᵢ〉| = " << mu_avg().norm() << "; written in groundstate.csv" << endl;
+    storeState(0);
+}
+
+double groundEnergy(const Vector3d* x, Vector3d* g) { // the energy N λ e of the state x and its gradient
+
+    for (int i = 0; i < N; i++)
+        mu[i] = x[i].cast<Real>();
+    updateSources();
+    calcBTotal();
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; i++)
+        g[i] = -energyField(i).cast<double>();
+    return N * lambda * magEnergy();
+}
+
+Vec3 energyField(int i) { // -∂(N λ e)/∂μᵢ of the state of Bₜ[]
+
+    // It is mᵢBₜ[i] of the dynamics; Bₜ[] has the mean field ½λ(δJᵢ〈s〉 + 〈δJₖsₖ〉) and the extra terms of the
+    // energy, see extraField().
+    #if POLYDISPERSE == 1
+        return moment[i] * BT[i];
+    #else
+        return BT[i];
+    #endif
+}
+
+void exportGroundState(const string& file, double E) { // writes the state and its energy e.
+
+    ofstream out(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    out << "lattice, " << lattice.id() << ", " << nSites << '\n'
+        << "L, " << L << '\n'
+        << "lambda, " << lambda << '\n'
+        << "B, " << BDC.transpose().format(CSVFormat) << '\n'
+        << setprecision(10) << "energy, " << E << '\n'
+        << "x, y, z, mu.x, mu.y, mu.z" << '\n';
+    for (int i = 0; i < N; i++)
+        out << r[i].transpose().format(CSVFormat) << ", " << mu[i].transpose().format(CSVFormat) << '\n';
+}
+
+bool warmStart(int rI, float lambda1, const Vec3& B1) { // starts from the nearest stored state of (λ₁, B₁).
+
+    #if WARM_START == 1
+        const float B[3] = {float(B1.x()), float(B1.y()), float(B1.z())};
+        const int k = states.nearest(lattice.id(), L, N, lambda1, B, dLambdaWarm, dBWarm, rI);
+        if ((k < 0) || !states.load(k, mu))
+            return false;
+        lambda = lambda1;
+        BDC = B1;
+        updateSources();
+        lout << "warm start from " << statesDir << "/" << states.entry(k).file << " (λ = " << states.entry(k).lambda
+             << ")" << endl;
+        executeSteps(decorrelationSteps);
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+void storeState(int rI) { // adds the current state to the state library.
+
+    #if WARM_START == 1
+        StateEntry e = {"", lattice.id(), L, N, lambda, {float(BDC.x()), float(BDC.y()), float(BDC.z())},
+                        runSeed, rI};
+        if (!states.save(e, mu))
+            lout << "Cannot write the state in " << statesDir << endl;
+    #endif
+}
+
+void executeSingleStep() { // executes a single time step.
+    executeSteps(1);
+}
+
+Vec3 relax(const Vec3& m, const Vec3& B, Real a) { // exact relaxation of m towards B in the time 2a
+
+    // dθ/dt = -½|B| sin θ for the angle θ between μ and B; so tan(θ/2) decays by exp(-a|B|).
+    const Real b = B.norm();
+    if (b == 0)
+        return m;
+    const Vec3 n = B / b;
+    const Vec3 p = m - m.dot(n) * n;        // the normal part of m
+    const Real s = p.norm();
+    if (s == 0)
+        return m;
+    const Real theta = 2 * atan(tan(0.5 * atan2(s, m.dot(n))) * exp(-a * b));
+    return cos(theta) * n + (sin(theta) / s) * p;
+}
+
+Vec3 stiffStep(const Vec3& m, const Vec3& B, const Vec3& W, Real a, Real b) { // semi-implicit step
+
+    // ½ relaxation, the rotation by the noise, ½ relaxation
+    Vec3 m1 = relax(m, B, 0.5 * a);
+    const Vec3 O = b * W;                   // rotation vector of the noise
+    const Real o = O.norm();
+    if (o > 0) {
+        const Vec3 u = O / o;
+        m1 = cos(o) * m1 + sin(o) * u.cross(m1) + (1 - cos(o)) * u.dot(m1) * u;
+    }
+    return relax(m1, B, 0.5 * a);
+}
+
+void executeSteps(int n) { // executes n time steps in one parallel region.
+
+    #if SAMPLER == 1                        // the sweeps of the Monte Carlo sampler
+        for (int c = 0; c < n; c++) {
+            sweep();
+            t += 1;
+            steps++;
+            if (observables.due(steps))
+                observables.measure(steps, t, lambda, N);
+        }
+        return;
+    #endif
+
+    #if ADAPTIVE_DT == 1                    // the steps of the controller which cover the time n Δt
+        const double t1 = t + (n - 1e-6) * dt;
+        while (t < t1)
+            adaptiveStep();
+        return;
+    #endif
+
+    // The steps are fused in a team of threads which lives for all n steps. Each thread keeps the same static
+    // slab of the sites in all loops; so a step needs two barriers: after Bₜ[] of all sites, which are needed
+    // before any μ is changed, and after the partial sums of the new μ[], which give 〈μᵢ〉 of the next step.
+    // The threads also reduce max|Bₜ| in the first barrier, and every thread chooses the same integrator for
+    // the step. With MTS == 1, the far field is refreshed in the same loop as Bₜ[] every mtsK steps, and every
+    // thread finds the same next mtsK from the partial sums of the refresh.
+    struct Partial {                        // partial sums of μ of a thread, padded to its own cache lines
+        Vec3A S, T;                         // Σ sᵢ and Σ δJᵢsᵢ
+        double BT2;                         // partial max|Bₜ|²
+        double dBfar, B2;                   // partial Σ|ΔB_far|² and Σ|Σⱼ J̃ᵢⱼ mⱼμⱼ|² of MTS == 1
+        char pad[64];
+    };
+    vector<Partial> partial(N_CPU);
+    long implicitSteps = 0;
+    #if MTS == 1
+        int interval = mtsK, age = mtsAge;  // the copies of mtsK and mtsAge in each thread
+        long refreshes = 0;
+    #endif
+
+    #if MTS == 1
+        #pragma omp parallel firstprivate(interval, age, refreshes, implicitSteps)
+    #else
+        #pragma omp parallel firstprivate(implicitSteps)
+    #endif
+    {
+        const int th = threadNum(), nT = threadCount();
+        #pragma omp single
+        if (int(partial.size()) < nT)
+            partial.resize(nT);
+
+        // partial sums of the initial sources
+        Sum<Vec3A, Policy::compensated> S, T;
+        #pragma omp for schedule(static) nowait
+        for (int i = 0; i < N; i++) {
+            S += source[i].cast<accum>();
+            T += (dJ[i] * source[i]).cast<accum>();
+        }
+        partial[th].S = S.value();
+        partial[th].T = T.value();
+        if (numa) {
+            #pragma omp barrier
+            muReplica.refresh(source);
+        }
+        #pragma omp barrier
+
+        for (int c = 0; c < n; c++) {
+            // mean field from the partial sums; every thread adds them in the same order.
+            Sum<Vec3A, Policy::compensated> M, MT;
+            for (int k = 0; k < nT; k++) {
+                M  += partial[k].S;
+                MT += partial[k].T;
+            }
+            const Vec3 mu_MF = (M.value() / N).cast<Real>(), nu = (MT.value() / N).cast<Real>();
+            const Vec3* m = numa ? muReplica.local() : source;
+
+            // Bₜ[]; the barrier after the loop keeps μ[] unchanged until all fields are calculated.
+            double BT2 = 0;
+            #if MTS == 1
+                const bool refresh = (age >= interval);
+                double dBfar = 0, B2 = 0;
+                #pragma omp for schedule(static) nowait
+                for (int i = 0; i < N; i++) {
+                    Vec3F BDs = nearField(i, m);
+                    if (refresh) {
+                        Vec3F BF = Vec3F::Zero();
+                        for (int j = 0; j < N; j++)
+                            BF += (Jtilda[i][j] * m[j]).template cast<Policy::field>();
+                        dBfar += (BF.template cast<Real>() - Bfar[i]).squaredNorm();
+                        B2    += (BF + BDs).squaredNorm();
+                        Bfar[i] = BF.cast<Real>();
+                    }
+                    Vec3 B = BDC + lambda * (BDs.cast<Real>() + Bfar[i] + 0.5 * (dJ[i] * mu_MF + nu));
+                    extraField(i, B);
+                    BT[i] = B;
+                    BT2 = max(BT2, double(B.squaredNorm()));
+                }
+                partial[th].dBfar = dBfar;
+                partial[th].B2    = B2;
+                partial[th].BT2   = BT2;
+                #pragma omp barrier
+                age++;
+                if (refresh) {              // all threads find the same k after the barrier.
+                    dBfar = B2 = 0;
+                    for (int p = 0; p < nT; p++) {
+                        dBfar += partial[p].dBfar;
+                        B2    += partial[p].B2;
+                    }
+                    const double err = (B2 > 0) ? sqrt(dBfar / B2) : 0;
+                    if (err > mtsTol)
+                        interval = max(1, interval / 2);
+                    else if (err < mtsTol / 2)
+                        interval = min(mtsKMax, 2 * interval);
+                    age = 1;
+                    refreshes++;
+                }
+            #else
+                #pragma omp for schedule(static) nowait
+                for (int i = 0; i < N; i++) {
+                    Vec3F BDs = Vec3F::Zero();
+                    for (int j = 0; j < N; j++)
+                        BDs += (Jtilda[i][j] * m[j]).template cast<Policy::field>();
+                    Vec3 B = BDC + lambda * (BDs.cast<Real>() + 0.5 * (dJ[i] * mu_MF + nu));
+                    extraField(i, B);
+                    BT[i] = B;
+                    BT2 = max(BT2, double(B.squaredNorm()));
+                }
+                partial[th].BT2 = BT2;
+                #pragma omp barrier
+            #endif
+
+            // The state of the step steps + c is measured by the team with its own Bₜ[] before any μ is changed;
+            // the barrier of the measurement keeps μ[] until it is done.
+            if (observables.due(steps + c))
+                observables.measure(steps + c, t + c * dt, lambda, N);
+
+            // The semi-implicit midpoint step is used if the torque of the strongest field is stiff.
+            #if SEMI_IMPLICIT == 1
+                for (int p = 0; p < nT; p++)
+                    BT2 = max(BT2, partial[p].BT2);
+                const bool implicit = (0.5 * dt * sqrt(BT2) > stiffLimit);
+                implicitSteps += implicit;
+            #else
+                const bool implicit = false;
+            #endif
+
+            // μ^{(n+1)} with white Gaussian 3d noise, and the partial sums of the new sources
+            Sum<Vec3A, Policy::compensated> S, T;
+            #pragma omp for schedule(static) nowait
+            for (int i = 0; i < N; i++) {
+                Vec3 W(rndN(), rndN(), rndN());
+                #if POLYDISPERSE == 1
+                    // the step of each dipole is scaled by its own Dᵢ and mᵢ
+                    if (implicit)
+                        mu[i] = stiffStep(mu[i], BT[i], W, drift[i], noise[i]);
+                    else
+                        mu[i] +=  drift[i] * ( BT[i] - mu[i].dot(BT[i]) * mu[i] ) +
+                                  noise[i] * W.cross(mu[i]);
+                    mu[i].normalize();
+                    source[i] = moment[i] * mu[i];
+                #else
+                    if (implicit)
+                        mu[i] = stiffStep(mu[i], BT[i], W, 0.5 * dt, sqrt(dt));
+                    else
+                        mu[i] +=  0.5 * dt * ( BT[i] - mu[i].dot(BT[i]) * mu[i] ) + // Note: |μ[i]| == 1
+                                  sqrt(dt) * W.cross(mu[i]);
+                    mu[i].normalize();
+                #endif
+                S += source[i].cast<accum>();
+                T += (dJ[i] * source[i]).cast<accum>();
+            }
+            partial[th].S = S.value();
+            partial[th].T = T.value();
+            if (numa) {
+                #pragma omp barrier
+                muReplica.refresh(source);
+            }
+            #pragma omp barrier
+        }
+
+        #pragma omp master
+        {
+            #if MTS == 1
+                mtsK = interval;
+                mtsAge = age;
+                mtsRefreshes += refreshes;
+            #endif
+            stiffSteps += implicitSteps;
+        }
+    }
+
+    for (int c = 0; c < n; c++)
+        t += dt;
+    steps += n;
+}
+
+int ticks() { // number of the Δt of the grid of t since the last call
+
+    #if (ADAPTIVE_DT == 1) && (SAMPLER == 0)
+        int n = 0;
+        while (t >= tick + (1 - 1e-6) * dt) {
+            tick += dt;
+            n++;
+        }
+        return n;
+    #else
+        return 1;                           // a step is Δt (or a sweep).
+    #endif
+}
+
+void sweep() { // executes a Monte Carlo sweep of SAMPLER == 1.
+
+    // The dipoles are updated in their order, and the running sums of sₖ and δJₖsₖ give the mean field of the
+    // others. A move μᵢ → m is accepted with min(1, exp(-ΔU)), where U is the energy of μᵢ which is not in the
+    // linear field h, i.e. the heat-bath proposal exp(mᵢ m·h) is exact for the rest of the energy.
+    // The tracked fields follow the changes of the sources since the last sweep, e.g. of a Hybrid MC update.
+    tracker.sync(source);
+    Vec3A S = Vec3A::Zero(), T = Vec3A::Zero();
+    for (int i = 0; i < N; i++) {
+        S += source[i].cast<accum>();
+        T += (dJ[i] * source[i]).cast<accum>();
+    }
+
+    for (int pass = 0; pass <= overRelax; pass++) {
+        for (int i = 0; i < N; i++) {
+            #if POLYDISPERSE == 1
+                const Real m = moment[i];
+            #else
+                const Real m = 1;
+            #endif
+            const Vec3 s0 = source[i];
+            const Vec3 mu_MF = ((S - s0.cast<accum>()) / N).cast<Real>();
+            const Vec3 nu = ((T - (dJ[i] * s0).cast<accum>()) / N).cast<Real>();
+            const Vec3 h = BDC + lambda * (dipolarField(i) + 0.5 * (dJ[i] * mu_MF + nu));
+
+            Vec3 m1;
+            if (pass == 0)                  // heat bath
+                m1 = heatBath(m * h);
+            else {                          // over-relaxation; the reflection about h keeps μᵢ·h.
+                const Real h2 = h.squaredNorm();
+                if (h2 == 0)
+                    continue;
+                m1 = ((2 * mu[i].dot(h) / h2) * h - mu[i]).normalized();
+            }
+
+            const double dU = localEnergy(i, m1) - localEnergy(i, mu[i]);
+            mcTrials++;
+            if ((dU > 0) && (rnd() >= exp(-dU)))
+                continue;
+            mcAccepted++;
+            mu[i] = m1;
+            #if POLYDISPERSE == 1
+                source[i] = m * m1;
+            #endif
+            S += (source[i] - s0).cast<accum>();
+            T += (dJ[i] * (source[i] - s0)).cast<accum>();
+            tracker.stage(i, source[i]);
+        }
+        tracker.flush();
+    }
+
+    if ((hmcInterval > 0) && (steps % hmcInterval == hmcInterval - 1))
+        hmcUpdate();
+
+    // Bₜ[] of the new state for the observables, without a full calculation of the fields
+    tracker.sync(source);
+    trackedFields();
+}
+
+void trackedFields() { // updates Bₜ[] from the tracked fields of SAMPLER == 1.
+
+    const Vec3 mu_MF = source_avg(), nu = dJ_avg();
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; i++) {
+        Vec3F BDs = tracker[i];
+        #if MTS == 1
+            BDs += nearField(i, source);
+        #endif
+        Vec3 B = BDC + lambda * (BDs.cast<Real>() + 0.5 * (dJ[i] * mu_MF + nu));
+        extraField(i, B);
+        BT[i] = B;
+    }
+}
+
+void hmcUpdate() { // executes a Hybrid MC update of all dipoles.
+
+    // The momenta pᵢ are on the tangent planes of μᵢ, and each leapfrog step is a half kick by the torques of
+    // energyField(), the rotation of (μᵢ, pᵢ) on the great circle of pᵢ, and a half kick. The kicks and the
+    // rotations conserve the volume of the phase space, so the update is exact with any fields; it is accepted
+    // with min(1, exp(-ΔH)), where H = N λ e + ½ Σ |pᵢ|². A rejected update restores μ[] and Bₜ[].
+    vector<Vec3> mu1(mu, mu + N), p(N), G(N);
+    calcBTotal();
+    vector<Vec3> B1(BT, BT + N);
+    double H0 = N * lambda * magEnergy();
+    for (int i = 0; i < N; i++) {
+        const Vec3 W(rndN(), rndN(), rndN());
+        p[i] = W - W.dot(mu[i]) * mu[i];
+        H0 += 0.5 * p[i].squaredNorm();
+    }
+
+    for (int c = 0; c < hmcSteps; c++) {
+        for (int k = 0; k < 2; k++) {       // the half kick of the start of the step, and of its end
+            if (k == 1) {
+                updateSources();
+                calcBTotal();
+            }
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < N; i++)     // the kicks of the state before any μᵢ is moved
+                G[i] = energyField(i);
+            for (int i = 0; i < N; i++) {
+                p[i] += (0.5 * hmcEps) * (G[i] - mu[i].dot(G[i]) * mu[i]);
+                if (k == 1)
+                    continue;
+                const Real a = p[i].norm();
+                if (a == 0)
+                    continue;
+                const Vec3 u = p[i] / a;
+                const Real C = cos(a * hmcEps), S = sin(a * hmcEps);
+                const Vec3 m0 = mu[i];
+                mu[i] = (C * m0 + S * u).normalized();
+                p[i] = a * (C * u - S * m0);
+            }
+        }
+    }
+
+    double H1 = N * lambda * magEnergy();
+    for (int i = 0; i < N; i++)
+        H1 += 0.5 * p[i].squaredNorm();
+
+    hmcTrials++;
+    if (rnd() < exp(H0 - H1))
+        hmcAccepted++;
+    else {
+        copy(mu1.begin(), mu1.end(), mu);
+        copy(B1.begin(), B1.end(), BT);
+        updateSources();
+    }
+}
+
+Vec3 heatBath(const Vec3& K) { // a direction drawn from exp(K·μ)
+
+    // cos θ of the angle θ with K has the density ∝ exp(|K| cos θ) on [-1, 1].
+    const double k = K.norm();
+    if (k < 1e-6)
+        return rndDir().cast<Real>();
+    const double u = rnd();
+    const double c = 1 + log(u + (1 - u) * exp(-2 * k)) / k;
+    const double s = sqrt(max(0., 1 - c * c)), phi = 2 * pi * rnd();
+    const Vec3 n = K / k;
+    const Vec3 e1 = n.unitOrthogonal(), e2 = n.cross(e1);
+    return (Real(c) * n + Real(s * cos(phi)) * e1 + Real(s * sin(phi)) * e2).normalized();
+}
+
+Mat3 selfCoupling(int i) { // J̃ᵢᵢ
+
+    #if MTS == 1                            // J̃ᵢᵢ is near.
+        for (int k = nearFirst[i]; k < nearFirst[i + 1]; k++)
+            if (nearIndex[k] == i)
+                return couplingMatrix<Real>(nearJ[k]);
+        return Mat3::Zero();
+    #else
+        return couplingMatrix<Real>(Jtilda[i][i]);
+    #endif
+}
+
+Vec3 dipolarField(int i) { // Σ_{j≠i} J̃ᵢⱼ mⱼμⱼ, the dipolar field of the others at i without λ
+
+    Vec3F B = tracker.field(i);             // with the staged moves
+    #if MTS == 1
+        B += nearField(i, source);
+    #endif
+    return B.cast<Real>() - selfCoupling(i) * source[i];
+}
+
+double localEnergy(int i, const Vec3& m) { // the energy of μᵢ = m which is not linear in the field of the others
+
+    // -½ λ mᵢ² m·(J̃ᵢᵢ + δJᵢ/N) m of the self coupling and the mean field, and the extra terms of Σₖ mₖEₖ
+    #if POLYDISPERSE == 1
+        const Real mi = moment[i];
+    #else
+        const Real mi = 1;
+    #endif
+    const Vec3 old = mu[i];
+    mu[i] = m;
+    #if POLYDISPERSE == 1
+        const double U = fields.local(i, mu, moment);
+    #else
+        const double U = fields.local(i, mu);
+    #endif
+    mu[i] = old;
+    return U - 0.5 * lambda * sqr(mi) * m.dot((selfCoupling(i) + dJ[i] / N) * m);
+}
+
+void adaptiveStep() { // executes an accepted step of ADAPTIVE_DT == 1.
+
+    calcBTotal();
+    if (observables.due(steps))             // the state of the start of the step, with its own Bₜ[]
+        observables.measure(steps, t, lambda, N);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; i++) {
+        muStart[i] = mu[i];
+        BStart[i]  = BT[i];
+    }
+
+    for (;;) {
+        const Real h = dtNow;
+        drawIncrement(0.5 * h, dW1);
+        drawIncrement(0.5 * h, dW2);
+
+        // the first step h/2 and the fields at its end
+        moveDipoles(muStart, BStart, dW1, 0.5 * h);
+        calcBTotal();
+
+        // RMS of the difference of the torque terms of the step h and the two steps h/2
+        double E2 = 0;
+        #pragma omp parallel for schedule(static) reduction(+: E2)
+        for (int i = 0; i < N; i++) {
+            #if POLYDISPERSE == 1
+                const Real c = 0.5 * drift[i] / dt; // ¼ Dᵢmᵢ
+            #else
+                const Real c = 0.25;
+            #endif
+            const Vec3 dTau = (BT[i] - mu[i].dot(BT[i]) * mu[i]) -
+                              (BStart[i] - muStart[i].dot(BStart[i]) * muStart[i]);
+            E2 += sqr(double(c * h * dTau.norm()));
+        }
+        const double err = sqrt(E2 / N);
+        const double f = (err > 0) ? 0.9 * pow(dtTol / err, 2. / 3) : 2; // the error grows like h^{3/2}.
+
+        if ((err <= dtTol) || (h <= dtMin)) { // the second step h/2
+            stiffSteps += moveDipoles(mu, BT, dW2, 0.5 * h);
+            t += h;
+            steps++;
+            dtSum += h;
+            dtLow  = min(dtLow, h);
+            dtHigh = max(dtHigh, h);
+            dtSteps++;
+            dtNow = max(dtMin, min(dtMax, Real(h * min(2., f))));
+            return;
+        }
+
+        // The step is rejected; its increments are the path of the next attempts, and μ[] is restored.
+        Increment I = {0.5 * h, vector<Vec3>(dW2, dW2 + N)};
+        pending.push_back(I);
+        I.W.assign(dW1, dW1 + N);
+        pending.push_back(I);
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < N; i++)
+            mu[i] = muStart[i];
+        updateSources();
+        rejections++;
+        dtRejected++;
+        dtNow = max(dtMin, Real(h * max(0.2, f)));
+    }
+}
+
+bool moveDipoles(const Vec3* m, const Vec3* B, const Vec3* W, Real h) { // moves μ[] from m[] in the time h
+
+    // The semi-implicit step is used if the torque of the strongest field is stiff; see executeSteps().
+    bool implicit = false;
+    #if SEMI_IMPLICIT == 1
+        double B2 = 0;
+        #pragma omp parallel for schedule(static) reduction(max: B2)
+        for (int i = 0; i < N; i++)
+            B2 = max(B2, double(B[i].squaredNorm()));
+        implicit = (0.5 * h * sqrt(B2) > stiffLimit);
+    #endif
+
+    // m may be μ; each dipole is read before it is written.
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; i++) {
+        #if POLYDISPERSE == 1
+            const Real a = drift[i] * h / dt, b = noise[i] / sqrt(dt); // ½ h Dᵢmᵢ and √Dᵢ
+        #else
+            const Real a = 0.5 * h, b = 1;
+        #endif
+        Vec3 m1;
+        if (implicit)
+            m1 = stiffStep(m[i], B[i], W[i], a, b);
+        else {
+            m1 = m[i] + a * ( B[i] - m[i].dot(B[i]) * m[i] ) + b * W[i].cross(m[i]);
+            m1.normalize();
+        }
+        mu[i] = m1;
+        #if POLYDISPERSE == 1
+            source[i] = moment[i] * m1;
+        #endif
+    }
+    return implicit;
+}
+
+void drawIncrement(double h, Vec3* W) { // the increments W[] of the next time h of the Brownian path
+
+    // The kept increments of the rejected steps are used first. A longer one is split by the Brownian bridge:
+    // given its sum over the time p, the part of the time h < p is normal with the mean (h/p) W and the variance
+    // h (p - h)/p, and the rest stays kept.
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < N; i++)
+        W[i] = Vec3::Zero();
+
+    while (h > 1e-9 * dt) {
+        if (pending.empty()) {              // a new part of the path
+            const Real s = sqrt(h);
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < N; i++)
+                W[i] += s * Vec3(rndN(), rndN(), rndN());
+            return;
+        }
+
+        Increment& p = pending.back();
+        Vec3* P = &p.W[0];
+        if (p.h <= h * (1 + 1e-9)) {        // the whole kept increment
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < N; i++)
+                W[i] += P[i];
+            h -= p.h;
+            pending.pop_back();
+        } else {                            // the Brownian bridge
+            const Real f = h / p.h, s = sqrt(f * (p.h - h));
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < N; i++) {
+                const Vec3 X = f * P[i] + s * Vec3(rndN(), rndN(), rndN());
+                W[i] += X;
+                P[i] -= X;
+            }
+            p.h -= h;
+            return;
+        }
+    }
+}
+
+void initHistory() { // removes the history of h of ADAPTIVE_DT == 1.
+
+    dtSum = 0;
+    dtLow = dtMax;
+    dtHigh = 0;
+    dtSteps = dtRejected = 0;
+}
+
+void execute() { // approaching to equilibrium
+    executeSteps(ceq);
+}
+
+void execute(float lambda1) { // simulates the system and changes λ from 0 to λ₁.
+
+    while (lambda < lambda1) {
+        execute();
+
+            //lambda += b0 + m * |lambda - lambdaC|;
+
+            //lambda += 1/(489.16 + 1.3 N) +
+            //          1/(40.35 + 0.73 L) * fabs(lambda - lambdaC);
+
+           lambda += 1/(1.2 * N + 465.8)
+                     m_lambda * fabs(lambda - lambdaC);
+
+        telemetry.publish(steps, t, lambda, mu_avg(), BDC);
+    }
+    // for being sure in the end that lambda is equal to λ₁.
+    lambda = lambda1;
+    execute();
+}
+
+void execute(int rI) { // simulates the system and increase λ from 0 to λₘₐₓ,
+                       // where rI is a realization index.
+    #if DATA == 1
+        exportSnapshot(1);
+        int cSnapshot = 2;
+    #endif
+
+    int c = 1;
+    int cRes = 1;
+    int cLambda = 0;                        // number of steps in the current λ step
+    exportResult(cRes++);
+
+    while (lambda < lambdaMax) { // changes λ from 0 to λₘₐₓ
+
+        executeSingleStep();
+        // 〈μᵢ〉
+        Vec3 M1 = mu_avg();
+
+        // The counters are advanced for each Δt of the step (one Δt without ADAPTIVE_DT); the state of the
+        // step is not sampled after λ is changed.
+        const float lambda0 = lambda;
+        for (int k = ticks(); k > 0; k--) {
+            if (lambda == lambda0)
+                sample(M1);
+
+            if (lambdaStepDone(++cLambda)) { // wait for equilibrium; ceq Δt ~ relaxation time?
+
+                cLambda = 0;
+
+                res << "," << endl;
+                exportResult(cRes++);
+
+                //lambda += b0 + m * |lambda - lambdaC|;
+                //lambda += 1/(489.16 + 1.3 N) +
+                //          1/(40.35 + 0.73 L) * fabs(lambda - lambdaC);
+
+                lambda += 1/(1.2 * N + 465.8)
+                         m_lambda * fabs(lambda - lambdaC);
+
+            }
+            #if DATA == 1
+                if (c % 40 == 0) {
+                    snapshot << "," << endl;
+                    exportSnapshot(cSnapshot++);
+                }
+            #endif
+            #if SNAPRING == 1
+                snapshotStep(c, M1);
+            #endif
+            c++;
+        }
+        telemetry.publish(steps, t, lambda, M1, BDC);
+    }
+
+    #if DYNAMICS == 1
+
+        lambda = lambdaMax;
+
+        for (int i = 0; i < ceq; ) { // last step of λ to λ_max
+        executeSingleStep();
+
+        for (int k = ticks(); k > 0; k--, i++) {
+            #if DATA == 1
+                if (c % 40 == 0) {
+                    snapshot << "," << endl;
+                    exportSnapshot(cSnapshot++);
+                }
+            #endif
+            #if SNAPRING == 1
+                snapshotStep(c, mu_avg());
+            #endif
+
+            c++;
+        }
+
+        telemetry.publish(steps, t, lambda, mu_avg(), BDC);
+        }
+
+        lout << "\n\nThe system reaches to the critical point.\n"
+            << "Now, the external field is turned on!" << endl;
+
+        // The DC magnetic field in 2ⁿᵈ part of dynamics.
+        BDC = BDC1;
+
+        lout << fixed << setprecision(4)
+            << "t = " << t << "\tB_DC = ("
+            << resetiosflags(std::ios_base::floatfield | std::ios_base::showpoint)
+            << setprecision(-1)                // resets the stream format
+            << BDC.transpose().format(CSVFormat) << ")\n" << endl;
+
+        BC.init();
+        initStat();
+        correlator.reset();
+        correlating = true;
+
+        while (t < tmax) { // dynamics of the system at λ_max
+            executeSingleStep();
+
+            // 〈μᵢ〉
+            Vec3 M1 = mu_avg();
+
+            for (int k = ticks(); k > 0; k--) {
+                sample(M1);
+
+                // wait for equilibrium; ceq Δt ~ relaxation time?
+                if (c % ceq == 0){
+                    res << "," << endl;
+                    exportResult(cRes++);
+
+                #if DATA >= 2
+                if ((c % 40 == 0) && (lambda > 0) && (rI == 1)) {
+                    snapshot << "," << endl;
+                    exportSnapshot(cSnapshot++);
+                }
+                #endif
+                }
+
+                #if SNAPRING == 1
+                    snapshotStep(c, M1);
+                #endif
+
+                c++;
+            }
+
+            telemetry.publish(steps, t, lambda, M1, BDC);
+        }
+
+    #endif  // DYNAMICS == 1
+
+    #if DATA == 1
+        snapshot << "}}" << endl;
+    #endif
+
+    res << "}}" << endl;
+    lout << '\n' << endl;
+}
+
+void executeHysteresis(int rI,
+                       const Vec3 dB,         // linear changes in the external magnetic field in each step of
+                       const float B0,        // simulation, B₀ shows the amplitude of magnetic field, and rI
+                       const float lambda0) { // is a realization index.
+
+    // Hysteresis loop has 3 sections, 0: B = [0, B₀], 1: B = [B₀, -B₀], 2: B = [-B₀, B₀].
+    int loop_counter = 0;
+    // to change direction of changing external B
+    int sign = +1;
+    // With WARM_START == 1, the equilibrium state of λ₀ is loaded from the state library; otherwise, it is
+    // approached by the ramp of λ to λ₀ and then added to the library.
+    if ((WARM_START == 1) && !warmStart(rI, lambda0, BDC)) {
+        execute(lambda0);
+        storeState(rI);
+    }
+    // fixed lambda, first point
+    lambda = lambda0;
+    // counter to saving results.
+    int cRes = 1;
+    exportResult(cRes++);
+
+    while (loop_counter < 3) {
+
+        execute();
+
+        res << "," << endl;
+        exportResult(cRes++);
+
+        BDC += sign * dB;
+
+        if ( BDC.norm() > B0 ) { // to prevent BDC to exceed the max/min value
+            loop_counter++;
+            sign *= -1;
+        }
+        telemetry.publish(steps, t, lambda, mu_avg(), BDC);
+    }
+    res << "}}" << endl;
+
+    lout << endl;
+}
+
+void executeRotationalB(int rI, const float B0) { // simulates a rotational external magnetic field, where B₀ shows
+                                                  // the amplitude of magnetic field and rI is a realization index.
+    // ΔB
+    const float dB = 0.01;
+    // Δθ
+    const float deltaTheta = 0.01 * pi;
+
+    // At first system must be at the critical point, and then B is increased to B₀; with WARM_START == 1,
+    // this state is loaded from the state library or added to it.
+    if (!warmStart(rI, lambdaC, Vec3(B0, 0, 0))) {
+        execute(lambdaC);
+
+        while (BDC.x() <= B0) {
+
+            execute();
+            BDC.x() += dB;
+
+            telemetry.publish(steps, t, lambda, mu_avg(), BDC);
+        }
+        storeState(rI);
+    }
+    int cRes = 1;
+    float theta = 0;
+    correlator.reset();
+    correlating = true;
+
+    // Simulating the rotating magnetic field, and simultaneously export the results.
+    while (theta <= 2 * pi ) {
+        BDC = Vec3(cos(theta), sin(theta), 0);
+
+        execute();
+
+        if (cRes > 1)
+            res << "," << endl;
+        exportResult(cRes++);
+
+
+        theta += deltaTheta;
+
+        telemetry.publish(steps, t, lambda, mu_avg(), BDC);
+    }
+    res << "}}" << endl;
+
+    lout << endl;
+}
+
+void exportHeader() { // exports the header to the snapshot stream
+
+    snapshot << fixed << setprecision(3);
+
+    // Header of the snapshot file
+    snapshot << "{\n"
+             << "\"lattice\": {\n"
+             << "\"items\": " << N << ",\n"
+             << "\"lacations\": [" << endl;
+
+    for (int i = 0; i < N; i++) {
+        snapshot << "\"(" << r[i].transpose().format(CSVFormat) << ")\"";
+
+        if (i != N - 1)
+            snapshot << ",\n";
+    }
+    snapshot << "]}\n,\n"
+             << "\"snapshot\": {" << endl;
+}
+
+void exportResult(int id) { // exports the current state to the res stream.
+
+    Vec3 mu = mu_avg();
+
+    // error bars of the λ step
+    double BCErr, chi, chiErr, C, CErr;
+    JK.estimate(binderOf, BCErr);
+    chi = JK.estimate(chiOf, chiErr);
+    C   = JK.estimate(heatOf, CErr);
+
+    // The order of the results is the same as resultNames[].
+    vector<double> x = {lambda, t, theta, magEnergy(), mu.norm(),
+                        BC.BC(true), BCErr, chi, chiErr, C,
+                        CErr, double(M2Bins.count()), M2Bins.tau(), BDC.x(), BDC.y(),
+                        BDC.z(), sqrt(sqr(mu.x()) + sqr(mu.y())), mu.x(), mu.y(), mu.z()};
+
+    // The correlations are averaged over the sublattices, and the topological charges are summed up.
+    #if CORRELATION == 1
+        vector<double> c(4 + L / 2, 0);
+        for (int s = 0; s < nSites; s++) {
+            corr.compute(::mu, s, nSites);
+            c[0] += corr.xi() / nSites;
+            c[1] += corr.S0() / nSites;
+            c[2] += corr.Smin() / nSites;
+            for (int n = 0; n <= L / 2; n++)
+                c[3 + n] += corr.G(n, 0) / nSites;
+        }
+        x.insert(x.end(), c.begin(), c.end());
+    #endif
+
+    #if TOPOLOGY == 1
+        Topology T = {0, 0, 0, 0};
+        for (int s = 0; s < nSites; s++) {
+            const Topology Ts = topology(::mu, L, L, a.cross(b).z() > 0, s, nSites);
+            T.vortices     += Ts.vortices;
+            T.antivortices += Ts.antivortices;
+            T.Q            += Ts.Q;
+            T.density      += Ts.density / nSites;
+        }
+        x.push_back(T.vortices);
+        x.push_back(T.antivortices);
+        x.push_back(T.Q);
+        x.push_back(T.density);
+    #endif
+
+    #if ADAPTIVE_DT == 1                    // the history of h in the λ step
+        x.push_back((dtSteps > 0) ? dtSum / dtSteps : dtNow);
+        x.push_back((dtSteps > 0) ? dtLow : dtNow);
+        x.push_back((dtSteps > 0) ? dtHigh : dtNow);
+        x.push_back(dtRejected);
+        initHistory();
+    #endif
+
+    #if RESULTS != 1
+        res << "\"" << id << "\": {\n"
+            << "\"items\": " << N;
+        for (size_t k = 0; k < x.size(); k++)
+            res << ",\n\"" << resultNames[k] << "\": " << x[k];
+        res << "}" << endl;
+    #endif
+
+    #if RESULTS != 0
+        ensemble.add(id, &x[0]);
+    #endif
+
+    #if HISTOGRAM == 1
+        H.lambda = lambda;
+        for (int k = 0; k < 3; k++)
+            H.B[k] = BDC[k];
+        H.write(hist);
+    #endif
+
+    initStat();
+}
+
+void exportSnapshot(int id) { // exports the current state to the snapshot stream
+
+    #if SNAPSHOT_CODEC == 1
+        codec.write(id, t, lambda, magEnergy(), mu);
+        return;
+    #endif
+
+    snapshot << "\"" << id << "\": {\n"
+             << "\"items\": " << N << ",\n"
+             << "\"lambda\":" << lambda << ",\n"
+             << "\"time\":"   << t << ",\n"
+             << "\"Energy\":" << magEnergy() << ",\n"
+             << "\"data\": [\n";
+
+    for (int i = 0; i < N; i++) {
+        snapshot << "\"(" << mu[i].transpose().format(CSVFormat) << ")\"";
+        if (i != N - 1)
+            snapshot << "," << endl;
+    }
+    snapshot << "]}" << endl;
+}
+
+void snapshotStep(long c, const Vec3& M1) { // records the cᵗʰ step in the snapshot ring if it is needed.
+
+    const float m = M1.norm();
+    const bool crossed = (ringM >= 0) && ((m - snapThreshold) * (ringM - snapThreshold) < 0);
+    ringM = m;
+
+    // decimation of the frames
+    const int interval = (fabs(lambda - lambdaC) < snapWindow) ? snapDense : snapSparse;
+    const bool keep = (c % interval == 0);
+
+    if (keep || crossed || (c % snapStride == 0))
+        ring.record(c, t, lambda, magEnergy(), mu, keep);
+    if (crossed)
+        ring.trigger();
+}
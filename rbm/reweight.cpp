@@ -0,0 +1,239 @@
+/***  Multi-histogram reweighting, Ver 0.1, Date: 19 Oct 2026 ******************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * This companion tool of rbm reads the energy histograms (histogram<r>.txt; see HISTOGRAM in rbm.cpp and
+ * histogram.h) which are recorded at discrete values of λ, and combines them by the Ferrenberg–Swendsen
+ * multi-histogram method. It then exports the continuous curves of the Binder cumulant U₄(λ), the
+ * susceptibility χ(λ) and the specific heat C(λ) with their jackknife error bars.
+ *
+ * Usage:
+ *   ./reweight λ₀ λ₁ points histogram1.txt histogram2.txt ...
+ *
+ * The reduced energy of the system is λ N e, where e is the magnetic energy per dipole (magEnergy()); so
+ * g(e) e^{-λ N e} is the distribution of e at λ. The histograms of λ steps with an external field are
+ * skipped, since the Zeeman energy does not scale with λ.
+ *
+ * The histograms of all files with the same λ are merged. The files are divided into NJ groups, and the
+ * error bars are calculated by leaving out one group at a time (jackknife).
+ */
+
+#include <cstdlib>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <math.h>
+#include <map>
+#include <vector>
+#include "histogram.h"
+
+using namespace std;
+
+const int NJ = 10;                          // maximum number of jackknife groups
+const double tol = 1e-8;                    // tolerance of the free energies
+const int maxIter = 100000;                 // maximum number of iterations
+
+typedef map<long, HistogramBin> Bins;
+
+struct Run {                                // all samples at a λ
+    double lambda;
+    long   n[NJ];                           // number of samples of the jackknife groups
+    Bins   bins[NJ];                        // histograms of the jackknife groups
+};
+
+int N = 0;                                  // number of dipoles
+vector<Run> runs;
+
+inline double sqr(double x) { return x * x; }
+
+// log(Σ exp(xᵢ)) without overflow
+double logSumExp(const vector<double>& x) {
+    double m = -HUGE_VAL;
+    for (size_t i = 0; i < x.size(); i++)
+        m = max(m, x[i]);
+    if (m == -HUGE_VAL)
+        return m;
+
+    double S = 0;
+    for (size_t i = 0; i < x.size(); i++)
+        S += exp(x[i] - m);
+    return m + log(S);
+}
+
+void addHistogram(const EnergyHistogram& H, int group) { // merges H into the run of its λ
+    size_t k = 0;
+    while ((k < runs.size()) && (fabs(runs[k].lambda - H.lambda) > 1e-6))
+        k++;
+
+    if (k == runs.size()) {
+        Run r;
+        r.lambda = H.lambda;
+        for (int g = 0; g < NJ; g++)
+            r.n[g] = 0;
+        runs.push_back(r);
+    }
+
+    runs[k].n[group] += H.samples;
+    for (Bins::const_iterator it = H.bins.begin(); it != H.bins.end(); ++it)
+        runs[k].bins[group][it->first] += it->second;
+}
+
+struct Result {
+    double U4, chi, C;
+};
+
+/* Solves the Ferrenberg–Swendsen equations for all jackknife groups except the group skip (skip = -1 uses all
+ * groups) and evaluates the observables at the points of lambdas. */
+vector<Result> reweight(const vector<double>& lambdas, int skip) {
+    // merges the histograms
+    vector<long> n(runs.size(), 0);
+    Bins total;
+    for (size_t k = 0; k < runs.size(); k++)
+        for (int g = 0; g < NJ; g++) {
+            if (g == skip) continue;
+            n[k] += runs[k].n[g];
+            for (Bins::const_iterator it = runs[k].bins[g].begin(); it != runs[k].bins[g].end(); ++it)
+                total[it->first] += it->second;
+        }
+
+    vector<double> E, lnH;                  // mean energy and log(count) of the bins
+    vector<HistogramBin> bins;
+    for (Bins::const_iterator it = total.begin(); it != total.end(); ++it) {
+        E.push_back(it->second.sE / it->second.count);
+        lnH.push_back(log(double(it->second.count)));
+        bins.push_back(it->second);
+    }
+    const size_t nE = E.size(), nR = runs.size();
+
+    // iterates the free energies f_k = -log Z(λ_k)
+    vector<double> f(nR, 0), lng(nE), x(max(nE, nR));
+    for (int iter = 0; iter < maxIter; iter++) {
+        for (size_t e = 0; e < nE; e++) {   // density of states g(e)
+            x.resize(nR);
+            for (size_t k = 0; k < nR; k++)
+                x[k] = (n[k] > 0) ? log(double(n[k])) + f[k] - runs[k].lambda * N * E[e] : -HUGE_VAL;
+            lng[e] = lnH[e] - logSumExp(x);
+        }
+
+        double df = 0, f0 = 0;
+        for (size_t k = 0; k < nR; k++) {   // new free energies
+            x.resize(nE);
+            for (size_t e = 0; e < nE; e++)
+                x[e] = lng[e] - runs[k].lambda * N * E[e];
+            const double fk = -logSumExp(x);
+            if (k == 0)
+                f0 = fk;
+            df = max(df, fabs((fk - f0) - f[k]));
+            f[k] = fk - f0;
+        }
+        if (df < tol)
+            break;
+    }
+
+    // observables at the requested λ
+    vector<Result> res(lambdas.size());
+    x.resize(nE);
+    for (size_t l = 0; l < lambdas.size(); l++) {
+        for (size_t e = 0; e < nE; e++)
+            x[e] = lng[e] - lambdas[l] * N * E[e];
+        const double lnZ = logSumExp(x);
+
+        double M = 0, M2 = 0, M4 = 0, e1 = 0, e2 = 0;
+        for (size_t e = 0; e < nE; e++) {
+            const double w = exp(x[e] - lnZ) / bins[e].count;
+            M  += w * bins[e].sM;
+            M2 += w * bins[e].sM2;
+            M4 += w * bins[e].sM4;
+            e1 += w * bins[e].sE;
+            e2 += w * bins[e].count * sqr(E[e]);
+        }
+        res[l].U4  = 1. - 3. * M4 / (5. * sqr(M2));
+        res[l].chi = N * (M2 - sqr(M));
+        res[l].C   = N * sqr(lambdas[l]) * (e2 - sqr(e1));
+    }
+    return res;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 5) {
+        cerr << "Usage: " << argv[0] << " λ₀ λ₁ points histogram1.txt histogram2.txt ..." << endl;
+        return 1;
+    }
+
+    const double lambda0 = atof(argv[1]), lambda1 = atof(argv[2]);
+    const int points = atoi(argv[3]);
+    const int nFiles = argc - 4;
+    const int nGroups = min(NJ, nFiles);
+
+    for (int i = 0; i < nFiles; i++) {
+        ifstream is(argv[i + 4]);
+        if (!is.good()) {
+            cerr << "Cannot open " << argv[i + 4] << endl;
+            return 1;
+        }
+
+        EnergyHistogram H;
+        int skipped = 0;
+        while (H.read(is)) {
+            if ((H.B[0] != 0) || (H.B[1] != 0) || (H.B[2] != 0)) {
+                skipped++;
+                continue;
+            }
+            if ((N != 0) && (N != H.N)) {
+                cerr << argv[i + 4] << ": the number of dipoles is different from the other histograms." << endl;
+                return 1;
+            }
+            N = H.N;
+            addHistogram(H, i % nGroups);
+        }
+        if (skipped > 0)
+            cerr << argv[i + 4] << ": " << skipped << " histograms with an external field are skipped." << endl;
+    }
+
+    if (runs.empty()) {
+        cerr << "No histogram is found." << endl;
+        return 1;
+    }
+    cerr << runs.size() << " values of λ are found in " << nFiles << " files." << endl;
+
+    vector<double> lambdas(points);
+    for (int l = 0; l < points; l++)
+        lambdas[l] = (points > 1) ? lambda0 + (lambda1 - lambda0) * l / (points - 1) : lambda0;
+
+    const vector<Result> all = reweight(lambdas, -1);
+
+    // jackknife error bars
+    vector<Result> S(points), S2(points);
+    for (int l = 0; l < points; l++)
+        S[l].U4 = S[l].chi = S[l].C = S2[l].U4 = S2[l].chi = S2[l].C = 0;
+
+    if (nGroups > 1)
+        for (int g = 0; g < nGroups; g++) {
+            const vector<Result> r = reweight(lambdas, g);
+            for (int l = 0; l < points; l++) {
+                S[l].U4  += r[l].U4;  S2[l].U4  += sqr(r[l].U4);
+                S[l].chi += r[l].chi; S2[l].chi += sqr(r[l].chi);
+                S[l].C   += r[l].C;   S2[l].C   += sqr(r[l].C);
+            }
+        }
+
+    cout << "lambda, U4, U4 error, chi, chi error, C, C error" << endl << setprecision(6);
+    for (int l = 0; l < points; l++) {
+        double eU4 = 0, eChi = 0, eC = 0;
+        if (nGroups > 1) {
+            const double m = nGroups, c = (m - 1) / m;
+            eU4  = sqrt(max(0., c * (S2[l].U4  - sqr(S[l].U4)  / m)));
+            eChi = sqrt(max(0., c * (S2[l].chi - sqr(S[l].chi) / m)));
+            eC   = sqrt(max(0., c * (S2[l].C   - sqr(S[l].C)   / m)));
+        }
+        cout << lambdas[l] << ", " << all[l].U4 << ", " << eU4 << ", " << all[l].chi << ", " << eChi
+             << ", " << all[l].C << ", " << eC << '\n';
+    }
+    return 0;
+}
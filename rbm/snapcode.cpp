@@ -0,0 +1,302 @@
+/***  Snapshot codec, Ver 0.1, Date: 19 Oct 2026 *******************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include "snapcode.h"
+
+using namespace std;
+
+const int MinBits = 4, MaxBits = 16;
+
+// Octahedral mapping
+// ==================
+inline double signOf(double x) { return (x < 0) ? -1 : 1; }
+
+// maps the unit vector v onto the square [-1, 1]².
+static void octahedral(const double* v, double& px, double& py) {
+    const double n = fabs(v[0]) + fabs(v[1]) + fabs(v[2]);
+    px = v[0] / n;
+    py = v[1] / n;
+    if (v[2] < 0) {
+        const double x = px;
+        px = (1 - fabs(py)) * signOf(x);
+        py = (1 - fabs(x))  * signOf(py);
+    }
+}
+
+// maps the code (u, w) of the square back to the unit vector v.
+static void octDecode(uint32_t u, uint32_t w, int bits, double* v) {
+    const double s = (1u << bits) - 1;
+    double px = u / s * 2 - 1, py = w / s * 2 - 1;
+    const double z = 1 - fabs(px) - fabs(py);
+    if (z < 0) {
+        const double x = px;
+        px = (1 - fabs(py)) * signOf(x);
+        py = (1 - fabs(x))  * signOf(py);
+    }
+    const double n = sqrt(px * px + py * py + z * z);
+    v[0] = px / n;
+    v[1] = py / n;
+    v[2] = z / n;
+}
+
+// angle between the unit vectors a and b
+static double angle(const double* a, const double* b) {
+    const double c[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    return atan2(sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]), a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+// the best code of the unit vector v among the four neighbouring grid points; returns the angular error.
+static double octEncode(const double* v, int bits, uint32_t& u, uint32_t& w) {
+    const double s = (1u << bits) - 1;
+    double px, py;
+    octahedral(v, px, py);
+    const double fx = (px + 1) / 2 * s, fy = (py + 1) / 2 * s;
+    const uint32_t x0 = uint32_t(min(max(floor(fx), 0.0), s)), y0 = uint32_t(min(max(floor(fy), 0.0), s));
+
+    double err = HUGE_VAL;
+    for (uint32_t x = x0; x <= min(x0 + 1, uint32_t(s)); x++)
+        for (uint32_t y = y0; y <= min(y0 + 1, uint32_t(s)); y++) {
+            double d[3];
+            octDecode(x, y, bits, d);
+            const double e = angle(v, d);
+            if (e < err) {
+                err = e;
+                u = x;
+                w = y;
+            }
+        }
+    return err;
+}
+
+// Rice code
+// =========
+// The zigzag values z = q 2ᵏ + r are written as q ones, a zero and k bits of r; q ≥ MaxQuotient is written as
+// MaxQuotient ones and the 33 bits of z.
+const int MaxQuotient = 24, RawBits = 33;
+
+inline uint64_t zigzag(int64_t d)    { return (uint64_t(d) << 1) ^ uint64_t(d >> 63); }
+inline int64_t  unzigzag(uint64_t z) { return int64_t(z >> 1) ^ -int64_t(z & 1); }
+
+inline int riceBits(uint64_t z, int k) {
+    const uint64_t q = z >> k;
+    return (q < MaxQuotient) ? int(q) + 1 + k : MaxQuotient + RawBits;
+}
+
+class BitWriter {
+  public:
+    explicit BitWriter(vector<uint8_t>& b) : b(b), n(0) {}
+    void put(uint64_t x, int bits) {        // writes the lowest bits of x.
+        for (int i = 0; i < bits; i++, n++) {
+            if (n % 8 == 0)
+                b.push_back(0);
+            if ((x >> i) & 1)
+                b.back() |= uint8_t(1 << (n % 8));
+        }
+    }
+    void rice(uint64_t z, int k) {
+        const uint64_t q = z >> k;
+        if (q < MaxQuotient) {
+            put((uint64_t(1) << q) - 1, int(q) + 1);
+            put(z, k);
+        }
+        else {
+            put((uint64_t(1) << MaxQuotient) - 1, MaxQuotient);
+            put(z, RawBits);
+        }
+    }
+  private:
+    vector<uint8_t>& b;
+    size_t n;                               // number of the written bits
+};
+
+class BitReader {
+  public:
+    BitReader(const vector<uint8_t>& b, size_t p) : b(b), n(8 * p) {}
+    bool get(uint64_t& x, int bits) {       // reads bits bits.
+        x = 0;
+        for (int i = 0; i < bits; i++, n++) {
+            if (n >= 8 * b.size())
+                return false;
+            x |= uint64_t((b[n / 8] >> (n % 8)) & 1) << i;
+        }
+        return true;
+    }
+    bool rice(uint64_t& z, int k) {
+        uint64_t q = 0, bit;
+        while ((q < MaxQuotient) && get(bit, 1) && bit)
+            q++;
+        if (n > 8 * b.size())
+            return false;
+        if (q == MaxQuotient)
+            return get(z, RawBits);
+        uint64_t r;
+        if (!get(r, k))
+            return false;
+        z = (q << k) | r;
+        return true;
+    }
+  private:
+    const vector<uint8_t>& b;
+    size_t n;                               // number of the read bits
+};
+
+// SnapshotEncoder
+// ===============
+int SnapshotEncoder::bitsOf(double bound) { // number of bits per coordinate for the angular error bound
+    // the maximum error on a Fibonacci sphere of directions
+    const int n = 20000;
+    const double golden = M_PI * (3 - sqrt(5.0));
+    for (int bits = MinBits; bits < MaxBits; bits++) {
+        double err = 0;
+        for (int k = 0; k < n; k++) {
+            const double z = 1 - (k + 0.5) * 2 / n, r = sqrt(1 - z * z);
+            const double v[3] = {r * cos(golden * k), r * sin(golden * k), z};
+            uint32_t u, w;
+            err = max(err, octEncode(v, bits, u, w));
+        }
+        if (err <= 0.75 * bound)
+            return bits;
+    }
+    return MaxBits;
+}
+
+bool SnapshotEncoder::open(const string& file, int N, double bound, int keyInterval) {
+    this->N = N;
+    this->keyInterval = max(keyInterval, 1);
+    nBits = (bound > 0) ? bitsOf(bound) : 0;
+    frames = 0;
+    nBytes = 0;
+    maxErr = 0;
+    m.assign(3 * N, 0);
+    code.assign((nBits ? 2 : 3) * N, 0);
+    prev.assign(code.size(), 0);
+    z.assign(code.size(), 0);
+
+    os.open(file.c_str(), ios_base::out | ios_base::trunc | ios_base::binary);
+    if (!os.good())
+        return false;
+
+    const int32_t h[3] = {N, nBits, this->keyInterval};
+    const float b = bound;
+    os.write("RBMSNAPZ", 8);
+    os.write(reinterpret_cast<const char*>(h), sizeof(h));
+    os.write(reinterpret_cast<const char*>(&b), sizeof(b));
+    nBytes = 8 + sizeof(h) + sizeof(b);
+    return os.good();
+}
+
+void SnapshotEncoder::encode(long step, double t, float lambda, float energy) {
+    if (nBits)
+        for (int i = 0; i < N; i++) {
+            const double v[3] = {m[3 * i], m[3 * i + 1], m[3 * i + 2]};
+            maxErr = max(maxErr, octEncode(v, nBits, code[2 * i], code[2 * i + 1]));
+        }
+    else
+        memcpy(&code[0], &m[0], code.size() * sizeof(uint32_t));
+
+    const bool key = (frames % keyInterval == 0);
+    if (key)
+        fill(prev.begin(), prev.end(), 0);
+
+    // the best parameter of the Rice code for the frame
+    for (size_t k = 0; k < code.size(); k++)
+        z[k] = zigzag(int64_t(code[k]) - int64_t(prev[k]));
+    int best = 0;
+    long bestBits = -1;
+    for (int k = 0; k < RawBits; k++) {
+        long bits = 0;
+        for (size_t i = 0; i < z.size(); i++)
+            bits += riceBits(z[i], k);
+        if ((bestBits < 0) || (bits < bestBits)) {
+            bestBits = bits;
+            best = k;
+        }
+    }
+
+    buffer.assign(1, uint8_t(best));
+    BitWriter w(buffer);
+    for (size_t k = 0; k < z.size(); k++)
+        w.rice(z[k], best);
+    prev.swap(code);
+
+    SnapshotFrame f;
+    f.frame = frames++;
+    f.step = step;
+    f.t = t;
+    f.lambda = lambda;
+    f.energy = energy;
+    f.flags = key ? Key : 0;
+    f.reserved = 0;
+
+    const uint32_t size = buffer.size();
+    os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    os.write(reinterpret_cast<const char*>(&f), sizeof(f));
+    os.write(reinterpret_cast<const char*>(&buffer[0]), size);
+    nBytes += sizeof(size) + sizeof(f) + size;
+}
+
+// SnapshotDecoder
+// ===============
+bool SnapshotDecoder::open(const string& file) {
+    is.open(file.c_str(), ios_base::in | ios_base::binary);
+
+    char magic[8];
+    int32_t h[3];
+    is.read(magic, 8);
+    is.read(reinterpret_cast<char*>(h), sizeof(h));
+    is.read(reinterpret_cast<char*>(&errBound), sizeof(errBound));
+    if (!is || (memcmp(magic, "RBMSNAPZ", 8) != 0))
+        return false;
+
+    N = h[0];
+    nBits = h[1];
+    keyInterval = h[2];
+    code.assign((nBits ? 2 : 3) * N, 0);
+    return true;
+}
+
+bool SnapshotDecoder::read(SnapshotFrame& f, vector<float>& mu) { // reads the next frame
+    uint32_t size;
+    if (!is.read(reinterpret_cast<char*>(&size), sizeof(size)) ||
+        !is.read(reinterpret_cast<char*>(&f), sizeof(f)))
+        return false;
+    buffer.resize(size);
+    if (size && !is.read(reinterpret_cast<char*>(&buffer[0]), size))
+        return false;
+
+    if (f.flags & SnapshotEncoder::Key)
+        fill(code.begin(), code.end(), 0);
+
+    if (buffer.empty())
+        return false;
+    BitReader r(buffer, 1);
+    for (size_t k = 0; k < code.size(); k++) {
+        uint64_t z;
+        if (!r.rice(z, buffer[0]))
+            return false;
+        code[k] = uint32_t(int64_t(code[k]) + unzigzag(z));
+    }
+
+    mu.resize(3 * N);
+    if (nBits)
+        for (int i = 0; i < N; i++) {
+            double v[3];
+            octDecode(code[2 * i], code[2 * i + 1], nBits, v);
+            for (int c = 0; c < 3; c++)
+                mu[3 * i + c] = v[c];
+        }
+    else
+        memcpy(&mu[0], &code[0], code.size() * sizeof(uint32_t));
+    return true;
+}
@@ -0,0 +1,89 @@
+/***  Snapshot codec, Ver 0.1, Date: 19 Oct 2026 *******************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * SnapshotEncoder writes the snapshots of the orientations in a compact binary file (snapshot<r>.rbz) and
+ * SnapshotDecoder reads them back.
+ *   In the lossy mode, each unit vector μ is mapped onto the octahedron |x| + |y| + |z| = 1, which is unfolded
+ * onto the square [-1, 1]², and the two coordinates are quantized by "bits" bits; so a dipole needs 2·bits bits.
+ * bits is the smallest value whose maximum angular error on a dense set of directions is below 3/4 of the
+ * requested bound, and the best of the four neighbouring grid points is chosen for each dipole. The largest
+ * error of the written data is kept in maxError().
+ *   In the lossless mode (bound == 0), the bit patterns of the float components are stored.
+ *   The codes of a frame are stored as the differences with the codes of the previous frame (temporal delta
+ * coding). The differences are zigzag mapped to the non-negative integers and written by the Rice code, whose
+ * parameter k is the best one for the frame; so a code needs about log₂|difference| + 2 bits. Every keyInterval
+ * frames is a key frame, which is coded against zero and can be decoded independently.
+ *
+ * The file is:
+ *   "RBMSNAPZ", int32 N, int32 bits (0 for the lossless mode), int32 keyInterval, float bound
+ *   frames: uint32 size of the codes, SnapshotFrame, uint8 k, codes
+ * where SnapshotFrame is the same as snapring.h and its flags shows the key frames (SnapshotEncoder::Key).
+ */
+
+#ifndef SNAPCODE_H
+
+#define SNAPCODE_H
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "snapring.h"
+
+class SnapshotEncoder {
+  public:
+    enum { Key = 2 };
+
+    // creates the file for N dipoles, where bound is the maximum angular error [rad] and 0 means lossless.
+    bool open(const std::string& file, int N, double bound, int keyInterval = 100);
+    void close() { os.close(); }
+
+    template <typename Vec>
+    void write(long step, double t, float lambda, float energy, const Vec* mu) {
+        for (int i = 0; i < N; i++)
+            for (int c = 0; c < 3; c++)
+                m[3 * i + c] = float(mu[i][c]);
+        encode(step, t, lambda, energy);
+    }
+
+    int bits() const { return nBits; }
+    double maxError() const { return maxErr; } // largest angular error of the written data [rad]
+    long bytes() const { return nBytes; }   // size of the written data
+
+    static int bitsOf(double bound);        // number of bits per coordinate for the angular error bound
+  private:
+    std::ofstream os;
+    int N, nBits, keyInterval;
+    long frames, nBytes;
+    double maxErr;
+    std::vector<float> m;                   // orientations of the current frame
+    std::vector<uint32_t> code, prev;       // codes of the current and the previous frame
+    std::vector<uint64_t> z;                // zigzag differences of the codes
+    std::vector<uint8_t> buffer;
+    void encode(long step, double t, float lambda, float energy);
+};
+
+class SnapshotDecoder {
+  public:
+    bool open(const std::string& file);
+    // reads the next frame; mu is 3N floats.
+    bool read(SnapshotFrame& f, std::vector<float>& mu);
+
+    int dipoles() const { return N; }
+    int bits() const { return nBits; }
+    float bound() const { return errBound; }
+  private:
+    std::ifstream is;
+    int N, nBits, keyInterval;
+    float errBound;
+    std::vector<uint32_t> code;
+    std::vector<uint8_t> buffer;
+};
+
+#endif
@@ -0,0 +1,87 @@
+/***  Snapshot ring dump, Ver 0.1, Date: 19 Oct 2026 ***************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * This companion tool of rbm exports the frames of a snapshot ring file (snapshot<r>.ring; see SNAPRING in
+ * rbm.cpp and snapring.h) or a compressed snapshot file (snapshot<r>.rbz; see SNAPSHOT_CODEC in rbm.cpp and
+ * snapcode.h) in the order of time with the dict. format of snapshot<r>.txt.
+ *
+ * Usage:
+ *   ./snapdump snapshot1.ring > snapshot1.txt
+ *   ./snapdump snapshot1.rbz > snapshot1.txt
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <math.h>
+#include <algorithm>
+#include "snapring.h"
+#include "snapcode.h"
+
+using namespace std;
+
+// exports a frame in the dict. format, where mu is 3N floats.
+void exportFrame(const SnapshotFrame* f, const float* mu, int N, bool first) {
+    if (!first)
+        cout << "," << endl;
+    cout << "\"" << f->frame + 1 << "\": {\n"
+         << "\"items\": " << N << ",\n"
+         << "\"step\":" << f->step << ",\n"
+         << "\"triggered\":" << ((f->flags & SnapshotRing::Triggered) ? 1 : 0) << ",\n"
+         << "\"lambda\":" << f->lambda << ",\n"
+         << "\"time\":" << f->t << ",\n"
+         << "\"Energy\":" << f->energy << ",\n"
+         << "\"data\": [\n";
+    for (int i = 0; i < N; i++) {
+        cout << "\"(" << mu[3 * i] << ", " << mu[3 * i + 1] << ", " << mu[3 * i + 2] << ")\"";
+        if (i != N - 1)
+            cout << ",\n";
+    }
+    cout << "]}";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        cerr << "Usage: " << argv[0] << " snapshot.ring|snapshot.rbz" << endl;
+        return 1;
+    }
+
+    cout << fixed << setprecision(3);
+
+    SnapshotRing ring;
+    SnapshotDecoder decoder;
+    if (ring.load(argv[1])) {
+        const vector<const SnapshotFrame*> frames = ring.ordered();
+        cout << "{\n\"frames\": " << ring.frames() << ",\n"
+             << "\"capacity\": " << ring.capacity() << ",\n"
+             << "\"snapshot\": {" << endl;
+        for (size_t k = 0; k < frames.size(); k++)
+            exportFrame(frames[k], ring.data(frames[k]), ring.dipoles(), k == 0);
+    }
+    else if (decoder.open(argv[1])) {
+        // The precision of the text is enough for the error bound, and all digits of float for the lossless mode.
+        if (decoder.bits() > 0)
+            cout << setprecision(max(3, int(ceil(-log10(decoder.bound()))) + 1));
+        else
+            cout << setprecision(9);
+        cout << "{\n\"bits\": " << decoder.bits() << ",\n"
+             << "\"snapshot\": {" << endl;
+        SnapshotFrame f;
+        vector<float> mu;
+        for (bool first = true; decoder.read(f, mu); first = false)
+            exportFrame(&f, &mu[0], decoder.dipoles(), first);
+    }
+    else {
+        cerr << "Cannot read the snapshot file: " << argv[1] << endl;
+        return 1;
+    }
+    cout << "}}" << endl;
+
+    return 0;
+}
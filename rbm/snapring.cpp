@@ -0,0 +1,152 @@
+/***  Snapshot ring, Ver 0.1, Date: 19 Oct 2026 ********************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include "snapring.h"
+
+using namespace std;
+
+bool SnapshotRing::open(const string& file, int N, int capacity, int history) {
+    close();
+    this->N = N;
+    size = sizeof(SnapshotHeader) + capacity * slotSize();
+
+    fd = ::open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, size) != 0) {
+        close();
+        return false;
+    }
+    void* p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        close();
+        return false;
+    }
+    base = static_cast<char*>(p);
+
+    SnapshotHeader* h = header();
+    memcpy(h->magic, "RBMRING1", 8);
+    h->N = N;
+    h->capacity = capacity;
+    h->frames = 0;
+    for (int k = 0; k < capacity; k++)
+        slot(k)->frame = -1;
+
+    // The history has at least one frame, which is the staging area of record().
+    this->history.assign(max(history, 1), Candidate());
+    for (size_t k = 0; k < this->history.size(); k++) {
+        this->history[k].mu.assign(3 * N, 0);
+        this->history[k].f.step = -1;
+        this->history[k].written = true;
+    }
+    last = 0;
+    return true;
+}
+
+bool SnapshotRing::load(const string& file) {
+    close();
+    fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (size_t(st.st_size) < sizeof(SnapshotHeader))) {
+        close();
+        return false;
+    }
+    size = st.st_size;
+    void* p = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        close();
+        return false;
+    }
+    base = static_cast<char*>(p);
+
+    N = header()->N;
+    if ((memcmp(header()->magic, "RBMRING1", 8) != 0) ||
+        (size < sizeof(SnapshotHeader) + header()->capacity * slotSize())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SnapshotRing::close() {
+    if (base) {
+        msync(base, size, MS_SYNC);
+        munmap(base, size);
+    }
+    if (fd >= 0)
+        ::close(fd);
+    base = NULL;
+    fd = -1;
+    size = 0;
+    history.clear();
+}
+
+int SnapshotRing::capacity() const {
+    return isOpen() ? header()->capacity : 0;
+}
+
+long SnapshotRing::frames() const {
+    return isOpen() ? header()->frames : 0;
+}
+
+vector<float>& SnapshotRing::stage(long step, double t, float lambda, float energy) {
+    last = (last + 1) % history.size();
+    Candidate& c = history[last];
+    c.f.frame = -1;
+    c.f.step = step;
+    c.f.t = t;
+    c.f.lambda = lambda;
+    c.f.energy = energy;
+    c.f.flags = 0;
+    c.f.reserved = 0;
+    c.written = false;
+    return c.mu;
+}
+
+void SnapshotRing::write(int h, int flags) { // writes the history[h] to the next slot.
+    Candidate& c = history[h];
+    if (c.written || (c.f.step < 0))
+        return;
+
+    SnapshotHeader* hd = header();
+    SnapshotFrame* s = slot(hd->frames % hd->capacity);
+    *s = c.f;
+    s->flags = flags;
+    memcpy(s + 1, &c.mu[0], 3 * sizeof(float) * N);
+    s->frame = hd->frames++;                // The frame is valid after its data.
+    c.written = true;
+}
+
+void SnapshotRing::trigger() { // writes the frames of the history which are not in the file.
+    if (!isOpen())
+        return;
+    // from the oldest to the newest
+    for (size_t k = 1; k <= history.size(); k++)
+        write((last + k) % history.size(), Triggered);
+}
+
+vector<const SnapshotFrame*> SnapshotRing::ordered() const { // the slots in the order of the frames
+    vector<const SnapshotFrame*> f;
+    for (int k = 0; k < capacity(); k++)
+        if (slot(k)->frame >= 0)
+            f.push_back(slot(k));
+    sort(f.begin(), f.end(), [](const SnapshotFrame* x, const SnapshotFrame* y) { return x->frame < y->frame; });
+    return f;
+}
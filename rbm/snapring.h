@@ -0,0 +1,106 @@
+/***  Snapshot ring, Ver 0.1, Date: 19 Oct 2026 ********************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * SnapshotRing stores the snapshots of the orientations in a memory-mapped binary file with a fixed number of
+ * slots (capacity). The frame k is written to the slot k mod capacity; so the file never grows and it always
+ * holds the last capacity frames. Which steps are recorded is decided by the caller (see snapshotStep() in
+ * rbm.cpp for the decimation of the frames).
+ *   For the triggered capture, the last "history" candidate frames are also kept in memory by record(), even if
+ * they are not written. trigger() then writes those of them which are not in the file yet; so the frames just
+ * before an event (e.g. a crossing of a threshold by an observable) are kept in the file.
+ *
+ * The file is:
+ *   SnapshotHeader
+ *   capacity x (SnapshotFrame, 3N floats of μ)
+ * where the frames of the slots are ordered by their index (frame), and the slots with frame < 0 are empty. The
+ * frames can be exported in the dict. format of snapshot<r>.txt by snapdump.cpp.
+ */
+
+#ifndef SNAPRING_H
+
+#define SNAPRING_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct SnapshotHeader {
+    char     magic[8];                      // "RBMRING1"
+    int32_t  N;                             // number of dipoles
+    int32_t  capacity;                      // number of slots
+    int64_t  frames;                        // number of the written frames
+};
+
+struct SnapshotFrame {
+    int64_t  frame;                         // index of the frame; -1 for an empty slot
+    int64_t  step;                          // number of the time step
+    double   t;                             // time [τ_D]
+    float    lambda;
+    float    energy;                        // magnetic energy per dipole
+    int32_t  flags;                         // Triggered if it is written by trigger()
+    int32_t  reserved;
+};
+
+class SnapshotRing {
+  public:
+    enum { Triggered = 1 };
+
+    SnapshotRing() : base(NULL), size(0), fd(-1), N(0) {}
+    ~SnapshotRing() { close(); }
+
+    // creates the ring file with capacity slots for N dipoles, where the last history frames are kept in memory.
+    bool open(const std::string& file, int N, int capacity, int history = 0);
+    // opens an existing ring file for reading.
+    bool load(const std::string& file);
+    void close();
+    bool isOpen() const { return base != NULL; }
+
+    // records the orientations of the step; they are written to the file if keep is true.
+    template <typename Vec>
+    void record(long step, double t, float lambda, float energy, const Vec* mu, bool keep) {
+        if (!isOpen())
+            return;
+        std::vector<float>& m = stage(step, t, lambda, energy);
+        for (int i = 0; i < N; i++)
+            for (int c = 0; c < 3; c++)
+                m[3 * i + c] = float(mu[i][c]);
+        if (keep)
+            write(last, 0);
+    }
+    void trigger();                         // writes the frames of the history which are not in the file.
+
+    int  dipoles()  const { return N; }
+    int  capacity() const;
+    long frames()   const;                  // number of the written frames
+    // the slots in the order of the frames; mu is 3N floats.
+    std::vector<const SnapshotFrame*> ordered() const;
+    const float* data(const SnapshotFrame* f) const { return reinterpret_cast<const float*>(f + 1); }
+  private:
+    struct Candidate {                      // a frame of the history
+        SnapshotFrame f;
+        std::vector<float> mu;
+        bool written;
+    };
+    char*  base;                            // the mapped file
+    size_t size;                            // size of the mapped file
+    int    fd;
+    int    N;
+    std::vector<Candidate> history;         // the last recorded frames (ring buffer)
+    int    last;                            // index of the last recorded frame in history
+
+    size_t slotSize() const { return sizeof(SnapshotFrame) + 3 * sizeof(float) * N; }
+    SnapshotHeader* header() const { return reinterpret_cast<SnapshotHeader*>(base); }
+    SnapshotFrame* slot(int k) const {
+        return reinterpret_cast<SnapshotFrame*>(base + sizeof(SnapshotHeader) + k * slotSize());
+    }
+    std::vector<float>& stage(long step, double t, float lambda, float energy);
+    void write(int h, int flags);           // writes the history[h] to the next slot.
+};
+
+#endif
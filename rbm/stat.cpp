@@ -0,0 +1,169 @@
+/***  Online statistics, Ver 0.1, Date: 19 Oct 2026 ****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <math.h>
+#include "stat.h"
+#include "utils.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// LogBinning
+
+LogBinning::LogBinning() {
+    init();
+}
+
+void LogBinning::init() {                   // removes all samples.
+    levels = 1;
+    for (int k = 0; k < MaxLevel; k++) {
+        n[k] = 0;
+        s[k] = s2[k] = pending[k] = 0;
+        hasPending[k] = false;
+    }
+}
+
+void LogBinning::sample(double x) {         // gets a new sample.
+    // The sample is a block of the level 0. Two successive blocks of the level k make a block of the level k+1.
+    for (int k = 0; k < MaxLevel; k++) {
+        n[k]++;
+        s[k]  += x;
+        s2[k] += sqr(x);
+
+        if (k + 1 > levels)
+            levels = k + 1;
+
+        if (!hasPending[k]) {
+            pending[k] = x;
+            hasPending[k] = true;
+            break;
+        }
+        x = 0.5 * (pending[k] + x);
+        hasPending[k] = false;
+    }
+}
+
+double LogBinning::mean() const {
+    return (n[0] > 0) ? s[0] / n[0] : 0;
+}
+
+double LogBinning::error(int k) const {     // naive error bar of the level k
+    if (n[k] < 2)
+        return 0;
+    const double m = s[k] / n[k];
+    const double var = s2[k] / n[k] - sqr(m);
+    return (var > 0) ? sqrt(var / (n[k] - 1)) : 0;
+}
+
+double LogBinning::error() const {          // error bar of the mean
+    double err = error(0);
+    for (int k = 1; k < levels; k++)
+        if (n[k] >= MinBlocks)
+            err = max(err, error(k));
+    return err;
+}
+
+double LogBinning::tau() const {            // integrated autocorrelation time
+    const double err0 = error(0);
+    if (err0 <= 0)
+        return 0;
+    return 0.5 * sqr(error() / err0);       // σ²_block = 2τ σ²_naive
+}
+// LogBinning
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Jackknife
+
+Jackknife::Jackknife(int nVar) : nVar(nVar) {
+    init();
+}
+
+void Jackknife::init() {                    // removes all samples.
+    nBins = 0;
+    binSize = 1;
+    n = cur = 0;
+    for (int v = 0; v < MaxVar; v++)
+        current[v] = 0;
+}
+
+void Jackknife::sample(const double* x) {   // gets a new sample of nVar variables.
+    for (int v = 0; v < nVar; v++)
+        current[v] += x[v];
+    n++;
+
+    if (++cur < binSize)
+        return;
+
+    for (int v = 0; v < nVar; v++) {
+        bins[nBins][v] = current[v];
+        current[v] = 0;
+    }
+    cur = 0;
+
+    if (++nBins == MaxBins) {               // the bins are full; so the pairs of bins are merged.
+        for (int b = 0; b < MaxBins / 2; b++)
+            for (int v = 0; v < nVar; v++)
+                bins[b][v] = bins[2*b][v] + bins[2*b + 1][v];
+        nBins = MaxBins / 2;
+        binSize *= 2;
+    }
+}
+
+double Jackknife::mean(int v) const {       // average of the vᵗʰ variable
+    if (n == 0)
+        return 0;
+
+    double S = current[v];
+    for (int b = 0; b < nBins; b++)
+        S += bins[b][v];
+    return S / n;
+}
+
+// estimates f(〈x〉) and its error bar, where f gets the averages of the variables.
+double Jackknife::estimate(double (*f)(const double* avg), double& error) const {
+    error = 0;
+    if (n == 0)
+        return 0;
+
+    double avg[MaxVar];
+    for (int v = 0; v < nVar; v++)
+        avg[v] = mean(v);
+    const double f0 = f(avg);
+
+    if (nBins < 2)
+        return f0;
+
+    // The samples of the incomplete bin are not used in the jackknife estimates.
+    double total[MaxVar];
+    for (int v = 0; v < nVar; v++) {
+        total[v] = 0;
+        for (int b = 0; b < nBins; b++)
+            total[v] += bins[b][v];
+    }
+    const double m = double(nBins - 1) * binSize;
+
+    double S = 0, S2 = 0;
+    for (int b = 0; b < nBins; b++) {
+        for (int v = 0; v < nVar; v++)
+            avg[v] = (total[v] - bins[b][v]) / m;
+        const double fb = f(avg);
+        S  += fb;
+        S2 += sqr(fb);
+    }
+    S  /= nBins;
+    S2 /= nBins;
+
+    error = sqrt(max(0., (nBins - 1) * (S2 - sqr(S))));
+    return f0;
+}
+// Jackknife
+//------------------------------------------------------------------------------
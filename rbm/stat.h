@@ -0,0 +1,65 @@
+/***  Online statistics, Ver 0.1, Date: 19 Oct 2026 ****************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * The following classes estimate the statistical errors of a correlated time series on the fly:
+ *   LogBinning  logarithmic binning (blocking) of one observable; it gives the mean, the error bar and the
+ *               integrated autocorrelation time in O(log n) memory.
+ *   Jackknife   the jackknife error of a derived quantity f(〈x₀〉, 〈x₁〉, ...), e.g. the Binder cumulant. The
+ *               samples are kept in a bounded number of bins whose size is doubled when the bins are full.
+ */
+
+#ifndef STAT_H
+
+#define STAT_H
+
+class LogBinning {                          // logarithmic binning of a time series
+  public:
+    LogBinning();
+    void init();                            // removes all samples.
+    void sample(double x);                  // gets a new sample.
+    long count() const { return n[0]; }     // number of samples
+    double mean() const;
+    double error() const;                   // error bar of the mean; the maximum of the errors of the
+                                            // levels with enough blocks is used.
+    double tau() const;                     // integrated autocorrelation time in the unit of samples
+  private:
+    static const int MaxLevel = 40;         // 2⁴⁰ samples
+    static const int MinBlocks = 32;        // minimum number of blocks of a reliable level
+    int    levels;                          // number of used levels
+    long   n[MaxLevel];                     // number of blocks of size 2ᵏ at the level k
+    double s[MaxLevel],                     // summation of the blocks
+           s2[MaxLevel],                    // and the square of the blocks.
+           pending[MaxLevel];               // the 1ˢᵗ half of the next block of the level k+1
+    bool   hasPending[MaxLevel];
+    double error(int k) const;              // naive error bar of the level k
+};
+
+class Jackknife {                           // jackknife error of the derived quantities
+  public:
+    static const int MaxVar = 8;            // maximum number of variables
+    static const int MaxBins = 64;          // maximum number of bins
+
+    Jackknife(int nVar = 1);
+    void init();                            // removes all samples.
+    void sample(const double* x);           // gets a new sample of nVar variables.
+    long count() const { return n; }        // number of samples
+    double mean(int v) const;               // average of the vᵗʰ variable
+    // estimates f(〈x〉) and its error bar, where f gets the averages of the variables.
+    double estimate(double (*f)(const double* avg), double& error) const;
+  private:
+    int    nVar;
+    int    nBins;                           // number of completed bins
+    long   binSize;                         // number of samples in each bin
+    long   n;                               // number of samples
+    long   cur;                             // number of samples in the current (incomplete) bin
+    double bins[MaxBins][MaxVar];           // summation of the samples of the bins
+    double current[MaxVar];                 // summation of the current bin
+};
+
+#endif
@@ -0,0 +1,110 @@
+/***  State library, Ver 0.1, Date: 19 Oct 2026 *******************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "statelib.h"
+
+using namespace std;
+
+bool StateLibrary::open(const string& dir) { // opens the directory; it is created if it does not exist.
+    this->dir = dir;
+    struct stat s;
+    if (stat(dir.c_str(), &s) == 0)
+        return S_ISDIR(s.st_mode);
+    return mkdir(dir.c_str(), 0755) == 0;
+}
+
+int StateLibrary::nearest(const string& lattice, int L, int N, float lambda, const float* B,
+                          float dLambda, float dB, int pick) {
+    readIndex();
+
+    // the distances of the states in the tolerances
+    vector<double> d(entries.size(), -1);
+    double dMin = -1;
+    for (size_t k = 0; k < entries.size(); k++) {
+        const StateEntry& e = entries[k];
+        if ((e.lattice != lattice) || (e.L != L) || (e.N != N))
+            continue;
+        const double dl = fabs(e.lambda - lambda);
+        const double db = sqrt(pow(e.B[0] - B[0], 2) + pow(e.B[1] - B[1], 2) + pow(e.B[2] - B[2], 2));
+        if ((dl > dLambda) || (db > dB))
+            continue;
+        d[k] = ((dLambda > 0) ? dl / dLambda : 0) + ((dB > 0) ? db / dB : 0);
+        if ((dMin < 0) || (d[k] < dMin))
+            dMin = d[k];
+    }
+    if (dMin < 0)
+        return -1;
+
+    // the equally near states
+    vector<int> near;
+    for (size_t k = 0; k < entries.size(); k++)
+        if ((d[k] >= 0) && (d[k] <= dMin + 1e-6))
+            near.push_back(k);
+    return near[((pick % int(near.size())) + near.size()) % near.size()];
+}
+
+bool StateLibrary::write(StateEntry& e, const vector<float>& m) {
+    e.file = "s" + to_string(e.seed) + "_r" + to_string(e.realization) + "_" + to_string(saved++) + ".state";
+
+    ofstream out((dir + "/" + e.file).c_str(), ios_base::out | ios_base::trunc | ios_base::binary);
+    StateHeader h;
+    memcpy(h.magic, "RBMSTAT1", 8);
+    h.N = e.N;
+    h.reserved = 0;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(&m[0]), m.size() * sizeof(float));
+    out.close();
+    if (!out)
+        return false;
+
+    // The line is written at once, after the state file is complete.
+    struct stat s;
+    const bool header = (stat(index().c_str(), &s) != 0);
+    ostringstream line;
+    line.precision(8);
+    if (header)
+        line << "file, lattice, L, N, lambda, B.x, B.y, B.z, seed, realization\n";
+    line << e.file << ", " << e.lattice << ", " << e.L << ", " << e.N << ", " << e.lambda << ", "
+         << e.B[0] << ", " << e.B[1] << ", " << e.B[2] << ", " << e.seed << ", " << e.realization << '\n';
+    ofstream idx(index().c_str(), ios_base::out | ios_base::app);
+    idx << line.str() << flush;
+    return bool(idx);
+}
+
+bool StateLibrary::read(int k, vector<float>& m) const {
+    ifstream in((dir + "/" + entries[k].file).c_str(), ios_base::in | ios_base::binary);
+    StateHeader h;
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h)) || (memcmp(h.magic, "RBMSTAT1", 8) != 0) ||
+        (h.N != entries[k].N))
+        return false;
+    m.resize(3 * h.N);
+    return bool(in.read(reinterpret_cast<char*>(&m[0]), m.size() * sizeof(float)));
+}
+
+void StateLibrary::readIndex() {
+    entries.clear();
+    ifstream in(index().c_str());
+    string line;
+    getline(in, line);                      // the header
+    while (getline(in, line)) {
+        replace(line.begin(), line.end(), ',', ' ');
+        istringstream s(line);
+        StateEntry e;
+        if (s >> e.file >> e.lattice >> e.L >> e.N >> e.lambda >> e.B[0] >> e.B[1] >> e.B[2] >> e.seed
+              >> e.realization)
+            entries.push_back(e);
+    }
+}
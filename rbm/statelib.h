@@ -0,0 +1,90 @@
+/***  State library, Ver 0.1, Date: 19 Oct 2026 *******************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * StateLibrary keeps the equilibrium states of the orientations in a directory, e.g. states/, so a protocol can
+ * start from a stored state near its (λ, B) instead of equilibrating it again. The directory has
+ *   index.csv                 one line for each state:
+ *                             file, lattice, L, N, lambda, B.x, B.y, B.z, seed, realization
+ *   s<seed>_r<r>_<k>.state    StateHeader and 3N floats of μ
+ * where seed is the seed of the process which stored the state and r is its realization. The index is read again
+ * by each nearest(); so the states of the other processes (shards) are found too. Each line of the index is
+ * appended by one write.
+ */
+
+#ifndef STATELIB_H
+
+#define STATELIB_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct StateHeader {
+    char     magic[8];                      // "RBMSTAT1"
+    int32_t  N;                             // number of dipoles
+    int32_t  reserved;
+};
+
+struct StateEntry {                         // a line of the index
+    std::string file;                       // name of the state file in the directory
+    std::string lattice;                    // id of the lattice, e.g. triangular or honeycomb_2
+    int L, N;
+    float lambda;
+    float B[3];                             // DC field [B⁎]
+    long seed;
+    int realization;
+};
+
+class StateLibrary {
+  public:
+    StateLibrary() : saved(0) {}
+
+    bool open(const std::string& dir);      // opens the directory; it is created if it does not exist.
+
+    // stores the orientations mu[0 ... e.N-1] with the keys of e; e.file is set by save().
+    template <typename Vec>
+    bool save(StateEntry e, const Vec* mu) {
+        std::vector<float> m(3 * e.N);
+        for (int i = 0; i < e.N; i++)
+            for (int c = 0; c < 3; c++)
+                m[3 * i + c] = float(mu[i][c]);
+        return write(e, m);
+    }
+
+    // index of the nearest state of the lattice, L and N to (λ, B), or -1 if there is no state with
+    // |Δλ| <= dLambda and |ΔB| <= dB. The distance is |Δλ|/dLambda + |ΔB|/dB, and pick chooses among the
+    // equally near states (pick mod their count), e.g. the realization, so the realizations do not share a state
+    // if there are enough of them.
+    int nearest(const std::string& lattice, int L, int N, float lambda, const float* B,
+                float dLambda, float dB, int pick);
+
+    // loads the orientations of the state k of the last nearest().
+    template <typename Vec>
+    bool load(int k, Vec* mu) const {
+        std::vector<float> m;
+        if (!read(k, m))
+            return false;
+        for (int i = 0; i < entries[k].N; i++)
+            mu[i] = Vec(m[3 * i], m[3 * i + 1], m[3 * i + 2]).normalized();
+        return true;
+    }
+
+    const StateEntry& entry(int k) const { return entries[k]; }
+  private:
+    std::string dir;
+    std::vector<StateEntry> entries;        // the index of the last nearest()
+    int saved;                              // number of the states which are stored by this process
+
+    std::string index() const { return dir + "/index.csv"; }
+    bool write(StateEntry& e, const std::vector<float>& m);
+    bool read(int k, std::vector<float>& m) const;
+    void readIndex();
+};
+
+#endif
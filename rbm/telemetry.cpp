@@ -0,0 +1,136 @@
+/***  Telemetry, Ver 0.1, Date: 19 Oct 2026 ************************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ */
+
+#include <cstdlib>
+#include <stdio.h>
+#include <ctime>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#ifdef __linux__
+  #include <unistd.h>
+  #include <sys/resource.h>
+  #include <sys/syscall.h>
+#endif
+#include "telemetry.h"
+#include "utils.h"
+
+using namespace std;
+
+void Telemetry::start(int rI, const string& statusFile, bool echo, double interval) {
+    stop();
+    realization = rI;
+    file = statusFile;
+    this->echo = echo;
+    this->interval = interval;
+    const float zero[3] = {0, 0, 0};
+    publish(0, 0, 0, zero, zero);
+    running = true;
+    reporter = thread(&Telemetry::report, this);
+}
+
+void Telemetry::stop() {
+    if (!running)
+        return;
+    {
+        lock_guard<mutex> lock(m);
+        running = false;
+    }
+    wake.notify_all();
+    reporter.join();
+
+    // The last progress line replaces the line of the reporter on the terminal, and it is kept in the log file.
+    const Sample s = read();
+    if (echo)
+        clog << '\r';
+    lout << progress(s, 0) << endl;
+}
+
+Telemetry::Sample Telemetry::read() const { // reads the counters without lock
+    Sample s;
+    unsigned s0, s1;
+    do {
+        s0 = seq.load(memory_order_acquire);
+        s.step   = data.step.load(memory_order_relaxed);
+        s.t      = data.t.load(memory_order_relaxed);
+        s.lambda = data.lambda.load(memory_order_relaxed);
+        for (int c = 0; c < 3; c++) {
+            s.M[c] = data.M[c].load(memory_order_relaxed);
+            s.B[c] = data.B[c].load(memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        s1 = seq.load(memory_order_relaxed);
+    } while ((s0 != s1) || (s0 & 1));       // retry if the producer was writing
+    return s;
+}
+
+string Telemetry::progress(const Sample& s, double rate) const {
+    ostringstream os;
+    os << fixed << setprecision(2)
+       << "t = "       << s.t
+       << "\tλ = "     << s.lambda
+       << "\t〈μᵢ〉 = (" << s.M[0] << ", " << s.M[1] << ", " << s.M[2] << ")"
+       << "\tB = ("    << s.B[0] << ", " << s.B[1] << ", " << s.B[2] << ")";
+    if (rate > 0)
+        os << "\t" << setprecision(0) << rate << " steps/s";
+    os << "       ";
+    return os.str();
+}
+
+void Telemetry::writeStatus(const Sample& s, double rate) const {
+    // The status file is replaced atomically; so a reader never sees a partial file.
+    const string temp = file + ".tmp";
+    {
+        ofstream os(temp.c_str(), ios_base::out | ios_base::trunc);
+        if (!os.good())
+            return;
+        os << setprecision(8)
+           << "{\"realization\": " << realization
+           << ", \"step\": "   << s.step
+           << ", \"time\": "   << s.t
+           << ", \"lambda\": " << s.lambda
+           << ", \"M\": ["     << s.M[0] << ", " << s.M[1] << ", " << s.M[2] << "]"
+           << ", \"B\": ["     << s.B[0] << ", " << s.B[1] << ", " << s.B[2] << "]"
+           << ", \"steps_per_sec\": " << setprecision(6) << rate
+           << ", \"updated\": " << long(time(NULL)) << "}" << endl;
+    }
+    rename(temp.c_str(), file.c_str());
+}
+
+void Telemetry::report() { // main loop of the reporter thread
+    #ifdef __linux__
+        // The reporter has the lowest priority; on Linux, nice is an attribute of the thread.
+        setpriority(PRIO_PROCESS, syscall(SYS_gettid), 19);
+    #endif
+
+    typedef chrono::steady_clock clock;
+    Sample last = read();
+    clock::time_point lastTime = clock::now();
+
+    unique_lock<mutex> lock(m);
+    while (running) {
+        wake.wait_for(lock, chrono::duration<double>(interval));
+        if (!running)
+            break;
+
+        const Sample s = read();
+        const clock::time_point now = clock::now();
+        const double dt = chrono::duration<double>(now - lastTime).count();
+        const double rate = (dt > 0) ? (s.step - last.step) / dt : 0;
+        last = s;
+        lastTime = now;
+
+        // Only the terminal is used here; the log file belongs to the simulation thread.
+        if (echo)
+            clog << '\r' << progress(s, rate) << flush;
+        writeStatus(s, rate);
+    }
+}
@@ -0,0 +1,87 @@
+/***  Telemetry, Ver 0.1, Date: 19 Oct 2026 ************************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * Telemetry moves the progress report out of the time loop. The simulation thread only publishes its counters
+ * (step, t, λ, 〈μᵢ〉 and B) by publish(), which is a few relaxed atomic stores in a sequence lock without any
+ * formatting, I/O or lock. A reporter thread with a low priority reads the last published counters at a fixed
+ * wall-clock rate, then it renders the progress line on the terminal and rewrites a machine-readable status
+ * file (JSON), e.g.
+ *   {"realization": 1, "step": 12000, "time": 120, "lambda": 0.52, "M": [0.1, 0.0, 0.2], "B": [0, 0, 0],
+ *    "steps_per_sec": 3810.5, "updated": 1792400000}
+ * The last progress line is written to the log by stop().
+ *
+ * MT Note:
+ *   Code should be linked with the -pthread switch of gcc.
+ */
+
+#ifndef TELEMETRY_H
+
+#define TELEMETRY_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class Telemetry {
+  public:
+    Telemetry() : running(false), seq(0) {}
+    ~Telemetry() { stop(); }
+
+    // starts the reporter thread of the realization rI, which writes the status file (and the progress line on the
+    // terminal if echo is true) every interval seconds.
+    void start(int rI, const std::string& statusFile, bool echo = true, double interval = 0.5);
+    void stop();                            // stops the reporter thread and logs the last progress line.
+
+    // publishes the counters; it must be called only by one thread (the simulation thread).
+    template <typename Vec>
+    void publish(long step, double t, float lambda, const Vec& M, const Vec& B) {
+        const unsigned s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);    // odd: writing
+        std::atomic_thread_fence(std::memory_order_release);
+        data.step.store(step, std::memory_order_relaxed);
+        data.t.store(t, std::memory_order_relaxed);
+        data.lambda.store(lambda, std::memory_order_relaxed);
+        for (int c = 0; c < 3; c++) {
+            data.M[c].store(float(M[c]), std::memory_order_relaxed);
+            data.B[c].store(float(B[c]), std::memory_order_relaxed);
+        }
+        seq.store(s + 2, std::memory_order_release);    // even: ready
+    }
+  private:
+    struct Counters {
+        std::atomic<long>   step;
+        std::atomic<double> t;
+        std::atomic<float>  lambda, M[3], B[3];
+    };
+    struct Sample {                         // a consistent copy of the counters
+        long   step;
+        double t;
+        float  lambda, M[3], B[3];
+    };
+
+    Counters data;
+    std::atomic<bool> running;
+    std::atomic<unsigned> seq;              // sequence lock of data
+    int realization;
+    bool echo;
+    std::string file;
+    double interval;
+    std::thread reporter;
+    std::mutex m;                           // only for waking the reporter up by stop()
+    std::condition_variable wake;
+
+    Sample read() const;                    // reads the counters without lock
+    std::string progress(const Sample& s, double rate) const;
+    void report();                          // main loop of the reporter thread
+    void writeStatus(const Sample& s, double rate) const;
+};
+
+#endif
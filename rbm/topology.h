@@ -0,0 +1,96 @@
+/***  Topological defects, Ver 0.1, Date: 19 Oct 2026 **************************
+ ***                                                                        ***
+ ***  Copyleft (ɔ) Nasim 2020-26, All lefts reserved!                       ***
+ ***                                                                        ***
+ ******************************************************************************
+ *
+ * This code is under construction. It might contain some errors.
+ * So you can try it at your own risk!
+ *
+ * topology() counts the vortices and antivortices of the in-plane projection of the orientations, and
+ * estimates the skyrmion number of the orientations on a periodic L₁ x L₂ Bravais lattice, where the dipole of
+ * the cell (i, j) is at i a + j b and it has the index i L₂ + j. Each cell is divided into two triangular
+ * plaquettes, (i, j) → (i+1, j) → (i, j+1) and (i+1, j) → (i+1, j+1) → (i, j+1), which are counterclockwise if
+ * (a x b)_z > 0.
+ *   The winding number of a plaquette is the sum of the changes of the in-plane angle φ = atan2(μ_y, μ_x) along
+ * its edges over 2π, where each change is wrapped to (-π, π]. +1 is a vortex and -1 is an antivortex.
+ *   The solid angle Ω of the orientations of a plaquette is given by (Berg & Lüscher)
+ *     tan(Ω/2) = μ₁·(μ₂ x μ₃) / (1 + μ₁·μ₂ + μ₂·μ₃ + μ₃·μ₁),
+ * and the skyrmion number is Q = ΣΩ / 4π. The skyrmion density Σ|Ω| / 4πN is also reported, since Q of the
+ * periodic lattice is an integer and the skyrmions and antiskyrmions cancel each other in Q.
+ */
+
+#ifndef TOPOLOGY_H
+
+#define TOPOLOGY_H
+
+#include <math.h>
+
+struct Topology {
+    int    vortices,                        // number of plaquettes with the winding number +1
+           antivortices;                    // number of plaquettes with the winding number -1
+    double Q,                               // skyrmion number ΣΩ / 4π
+           density;                         // skyrmion density Σ|Ω| / 4πN
+};
+
+inline double wrapAngle(double d) {         // wraps an angle to (-π, π]
+    while (d > M_PI)   d -= 2 * M_PI;
+    while (d <= -M_PI) d += 2 * M_PI;
+    return d;
+}
+
+// winding number of the in-plane angles of the triangle φ₁ → φ₂ → φ₃
+inline int winding(double p1, double p2, double p3) {
+    const double w = wrapAngle(p2 - p1) + wrapAngle(p3 - p2) + wrapAngle(p1 - p3);
+    return int(floor(w / (2 * M_PI) + 0.5));
+}
+
+// solid angle of the triangle of the unit vectors m1 → m2 → m3
+template <typename Vec>
+inline double solidAngle(const Vec& m1, const Vec& m2, const Vec& m3) {
+    const double num = m1.dot(m2.cross(m3));
+    const double den = 1 + m1.dot(m2) + m2.dot(m3) + m3.dot(m1);
+    return 2 * atan2(num, den);
+}
+
+// counts the topological defects of mu[offset + stride * (i L₂ + j)]; ccw shows if (a x b)_z > 0.
+template <typename Vec>
+Topology topology(const Vec* mu, int L1, int L2, bool ccw = true, int offset = 0, int stride = 1) {
+    const int sign = ccw ? 1 : -1;
+    int nv = 0, na = 0;
+    double Q = 0, Qabs = 0;
+
+    #pragma omp parallel for reduction(+: nv, na, Q, Qabs)
+    for (int i = 0; i < L1; i++) {
+        const int i1 = (i + 1) % L1;
+        for (int j = 0; j < L2; j++) {
+            const int j1 = (j + 1) % L2;
+            const Vec& m00 = mu[offset + stride * (i  * L2 + j )];
+            const Vec& m10 = mu[offset + stride * (i1 * L2 + j )];
+            const Vec& m01 = mu[offset + stride * (i  * L2 + j1)];
+            const Vec& m11 = mu[offset + stride * (i1 * L2 + j1)];
+
+            const double p00 = atan2(m00.y(), m00.x()), p10 = atan2(m10.y(), m10.x()),
+                         p01 = atan2(m01.y(), m01.x()), p11 = atan2(m11.y(), m11.x());
+
+            const int w1 = sign * winding(p00, p10, p01),
+                      w2 = sign * winding(p10, p11, p01);
+            nv += (w1 > 0) + (w2 > 0);
+            na += (w1 < 0) + (w2 < 0);
+
+            const double O1 = sign * solidAngle(m00, m10, m01),
+                         O2 = sign * solidAngle(m10, m11, m01);
+            Q    += O1 + O2;
+            Qabs += fabs(O1) + fabs(O2);
+        }
+    }
+
+    Topology T;
+    T.vortices = nv;
+    T.antivortices = na;
+    T.Q = Q / (4 * M_PI);
+    T.density = Qabs / (4 * M_PI * L1 * L2);
+    return T;
+}
+
+#endif